@@ -292,7 +292,8 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev) &&
+      NETDEV_GSOSIZE(dev) == 0)
     {
       nerr("ERROR: Packet too long to send!\n");
       ret = -EMSGSIZE;
@@ -639,6 +640,13 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
 #endif
 #if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
     defined(CONFIG_DRIVERS_IEEE80211)
+#ifdef CONFIG_NETDEV_GRO
+          if (netdev_gro_receive(dev, eth_input))
+            {
+              break;
+            }
+#endif
+
           eth_input(dev);
           break;
 #endif
@@ -658,6 +666,12 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           break;
         }
     }
+
+#ifdef CONFIG_NETDEV_GRO
+  /* Pass up the segments still held at the end of the burst */
+
+  netdev_gro_flush(dev, eth_input);
+#endif
 }
 
 /****************************************************************************
@@ -1395,7 +1409,13 @@ FAR netpkt_t *netpkt_alloc(FAR struct netdev_lowerhalf_s *dev,
       return NULL;
     }
 
-  pkt = iob_tryalloc(false);
+  /* A received frame is filled by the device in one go, so hint a whole
+   * frame to get a large I/O buffer if they are available.
+   */
+
+  pkt = iob_tryalloc_hint(false, type == NETPKT_RX ?
+                          CONFIG_NET_LL_GUARDSIZE +
+                          NETDEV_PKTSIZE(&dev->netdev) : 0);
   if (pkt == NULL)
     {
       atomic_fetch_add(&dev->quota[type], 1);
@@ -65,6 +65,8 @@ extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
 extern const struct procfs_operations g_meminfo_operations;
 extern const struct procfs_operations g_memdump_operations;
+extern const struct procfs_operations g_heapstat_operations;
+extern const struct procfs_operations g_memzone_operations;
 extern const struct procfs_operations g_mempool_operations;
 extern const struct procfs_operations g_module_operations;
 extern const struct procfs_operations g_pm_operations;
@@ -141,6 +143,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/usage",     &g_mount_operations,    PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_MM_HEAP_STATISTICS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
+  { "heapstat",     &g_heapstat_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   { "iobinfo",      &g_iobinfo_operations,  PROCFS_FILE_TYPE   },
 #endif
@@ -154,6 +161,9 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "memdump",      &g_memdump_operations,  PROCFS_FILE_TYPE   },
 #  endif
   { "meminfo",      &g_meminfo_operations,  PROCFS_FILE_TYPE   },
+#  ifdef CONFIG_MM_HEAP_ZONES
+  { "memzone",      &g_memzone_operations,  PROCFS_FILE_TYPE   },
+#  endif
 #endif
 
 #if defined(CONFIG_MM_HEAP_MEMPOOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
@@ -180,6 +180,20 @@ static int critmon_close(FAR struct file *filep)
 
 /****************************************************************************
  * Name: critmon_read_cpu
+ *
+ * Description:
+ *   Generate the line for one CPU.  The comma-separated fields are:
+ *
+ *   1. The CPU number
+ *   2. The maximum time with pre-emption disabled
+ *   3. The maximum time within a critical section
+ *   4. The total time within a critical section
+ *
+ *   Field 2 is omitted if CONFIG_SCHED_CRITMONITOR_MAXTIME_PREEMPTION is
+ *   negative, and fields 3 and 4 if
+ *   CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION is negative.  All times are
+ *   in seconds and cover the interval since the previous read.
+ *
  ****************************************************************************/
 
 static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
@@ -187,6 +201,10 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
                                 FAR off_t *offset, int cpu)
 {
   struct timespec maxtime;
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0
+  unsigned long freq;
+  uint64_t total;
+#endif
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -273,6 +291,32 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   buffer    += copysize;
   buflen    -= copysize;
 
+  if (buflen <= 0)
+    {
+      return totalsize;
+    }
+
+  /* Convert and generate output for total time in a critical section
+   * since the last read, then reset it.  The total is 64 bits wide and
+   * may not fit in the clock_t taken by perf_convert().
+   */
+
+  total = g_crit_total[cpu];
+  g_crit_total[cpu] = 0;
+
+  freq = perf_getfreq();
+  maxtime.tv_sec  = total / freq;
+  maxtime.tv_nsec = (total % freq) * NSEC_PER_SEC / freq;
+
+  linesize = procfs_snprintf(attr->line, CRITMON_LINELEN, ",%lu.%09lu",
+                             (unsigned long)maxtime.tv_sec,
+                             (unsigned long)maxtime.tv_nsec);
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  buflen    -= copysize;
+
   if (buflen <= 0)
     {
       return totalsize;
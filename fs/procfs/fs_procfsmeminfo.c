@@ -108,6 +108,14 @@ static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
 #endif
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_MM_HEAP_STATISTICS
+static ssize_t heapstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+#endif
+#ifdef CONFIG_MM_HEAP_ZONES
+static ssize_t memzone_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+#endif
 static int     meminfo_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     meminfo_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -153,6 +161,40 @@ const struct procfs_operations g_memdump_operations =
 };
 #endif
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+const struct procfs_operations g_heapstat_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  heapstat_read,  /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_ZONES
+const struct procfs_operations g_memzone_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memzone_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
 static FAR struct procfs_meminfo_entry_s *g_procfs_meminfo = NULL;
 
 /****************************************************************************
@@ -409,6 +451,179 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: heapstat_read
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_STATISTICS
+static ssize_t heapstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+  FAR struct meminfo_file_s *procfile;
+  FAR struct mm_heapstat_s *stat;
+  size_t linesize;
+  size_t copysize = 0;
+  size_t totalsize = 0;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* The histograms are too large for the stack */
+
+  stat = fs_heap_malloc(sizeof(struct mm_heapstat_s));
+  if (stat == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (buflen == 0)
+        {
+          break;
+        }
+
+      mm_heapstat(entry->heap, stat);
+
+      /* The first lines are the largest free chunk trend and the headers */
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%s: largest %lu minlargest %lu\n"
+                                   "%11s%11s%11s%11s\n",
+                                   entry->name,
+                                   (unsigned long)stat->largest,
+                                   (unsigned long)stat->minlargest,
+                                   "below", "nfree", "malloc", "free");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      /* Followed by the non-empty log2 buckets, the sizes of the free
+       * chunks and the mm_malloc()/mm_free() cycles share the same bounds.
+       */
+
+      for (i = 0; i < MM_STAT_NBUCKETS && buflen > 0; i++)
+        {
+          if (stat->freehist[i] == 0 && stat->mallocs[i] == 0 &&
+              stat->frees[i] == 0)
+            {
+              continue;
+            }
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%11lu%11lu%11lu%11lu\n",
+                                       i < MM_STAT_NBUCKETS - 1 ?
+                                       1ul << i : ULONG_MAX,
+                                       stat->freehist[i], stat->mallocs[i],
+                                       stat->frees[i]);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
+  fs_heap_free(stat);
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: memzone_read
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_ZONES
+static FAR const char *memzone_heapname(FAR struct mm_heap_s *heap)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (entry->heap == heap)
+        {
+          return entry->name;
+        }
+    }
+
+  return "-";
+}
+
+static ssize_t memzone_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct meminfo_file_s *procfile;
+  struct mm_zoneinfo_s info;
+  struct mallinfo minfo;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  linesize  = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                              "%-8s%-12s%-12s%11s%11s%11s%11s\n",
+                              "zone", "heap", "home", "allocs",
+                              "fallbacks", "free", "largest");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  for (i = 0; buflen > copysize && mm_zoneinfo(i, &info) == OK; i++)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      minfo      = mm_mallinfo(info.heap);
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%-8s%-12s%-12s%11lu%11lu%11lu%11lu\n",
+                                   info.zone == MM_ZONE_FAST ?
+                                   "fast" : "normal",
+                                   memzone_heapname(info.heap),
+                                   memzone_heapname(info.home),
+                                   info.allocs, info.fallbacks,
+                                   (unsigned long)minfo.fordblks,
+                                   (unsigned long)minfo.mxordblk);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: memdump_read
  ****************************************************************************/
@@ -42,6 +42,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -53,8 +54,12 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rnode;     /* Link in the ready list */
   epoll_data_t             data;
-  bool                     notified;
+  bool                     notified;  /* In the ready list */
+  pollevent_t              revents;   /* The events notified and not yet
+                                       * reported, protected by rlock
+                                       */
   struct pollfd            pfd;
   FAR struct file         *filep;
   FAR struct epoll_head_s *eph;
@@ -68,13 +73,19 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rlock;    /* Protect the ready list */
+  struct list_node      ready;    /* The ready list, store the setuped epoll
+                                   * node with pending events, in the order
+                                   * of their notification.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
                                    * epoll node.
                                    */
   struct list_node      teardown; /* The teardown list, store all the epoll
-                                   * node notified after epoll_wait finish,
-                                   * these epoll node should be setup again
-                                   * to check the pending poll notification.
+                                   * node reported by epoll_wait without
+                                   * EPOLLET, these epoll node should be
+                                   * setup again to check whether the events
+                                   * are still pending.
                                    */
   struct list_node      oneshot;  /* The oneshot list, store all the epoll
                                    * node notified after epoll_wait and with
@@ -163,6 +174,51 @@ static FAR epoll_head_t *epoll_head_from_fd(int fd, FAR struct file **filep)
   return (*filep)->f_priv;
 }
 
+/****************************************************************************
+ * Name: epoll_post
+ *
+ * Description:
+ *   Wake up the waiter of the epoll, at most one wake-up is pending.
+ *
+ ****************************************************************************/
+
+static void epoll_post(FAR epoll_head_t *eph)
+{
+  int semcount = 0;
+
+  nxsem_get_value(&eph->sem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&eph->sem);
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_node_teardown
+ *
+ * Description:
+ *   Teardown the poll of an epoll node and remove it from the ready list,
+ *   where it may have been put until the teardown.
+ *
+ ****************************************************************************/
+
+static void epoll_node_teardown(FAR epoll_head_t *eph,
+                                FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  file_poll(epn->filep, &epn->pfd, false);
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (epn->notified)
+    {
+      list_delete(&epn->rnode);
+      epn->notified = false;
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
 static int epoll_do_open(FAR struct file *filep)
 {
   FAR epoll_head_t *eph = filep->f_priv;
@@ -199,7 +255,7 @@ static int epoll_do_close(FAR struct file *filep)
       nxmutex_destroy(&eph->lock);
       list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
         {
-          file_poll(epn->filep, &epn->pfd, false);
+          epoll_node_teardown(eph, epn);
           file_put(epn->filep);
         }
 
@@ -239,11 +295,13 @@ static int epoll_do_create(int size, int flags)
   eph->size = size;
   nxmutex_init(&eph->lock);
   nxsem_init(&eph->sem, 0, 0);
+  spin_lock_init(&eph->rlock);
 
   /* List initialize */
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  list_initialize(&eph->ready);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -274,7 +332,7 @@ static int epoll_do_create(int size, int flags)
  * Name: epoll_setup
  *
  * Description:
- *   Setup all the fd.
+ *   Setup again the fd reported by the last epoll_wait() without EPOLLET.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -302,7 +360,7 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->notified    = false;
+      epn->revents     = 0;
       epn->pfd.revents = 0;
       ret = file_poll(epn->filep, &epn->pfd, true);
       if (ret < 0)
@@ -324,8 +382,11 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notified fd and check the notified fd's event with user
- *   expected event.
+ *   Collect the events of the fd in the ready list.  Only the fd that were
+ *   notified are visited, the others stay setup.  The reported fd are
+ *   teardown and setup again by the next epoll_wait() to check whether the
+ *   events are still pending, except with EPOLLET:  Such fd stay setup and
+ *   are only reported again on the next notification.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -341,43 +402,59 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
+  bool more;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  flags = spin_lock_irqsave(&eph->rlock);
+  while (i < maxevents && !list_is_empty(&eph->ready))
     {
-      /* Only check the notified fd */
+      epn = container_of(list_remove_head(&eph->ready), epoll_node_t,
+                         rnode);
+      epn->notified = false;
 
-      if (!epn->notified)
-        {
-          continue;
-        }
-
-      /* Teradown all the notified fd */
+      /* Consume the events notified so far, an edge triggered fd only
+       * reports the events notified since.
+       */
 
-      file_poll(epn->filep, &epn->pfd, false);
-      list_delete(&epn->node);
+      revents      = epn->revents;
+      epn->revents = 0;
+      spin_unlock_irqrestore(&eph->rlock, flags);
 
-      if (epn->pfd.revents != 0 && i < maxevents)
+      if (revents != 0)
         {
           evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
+          evs[i++].events = revents;
+
           if ((epn->pfd.events & EPOLLONESHOT) != 0)
             {
+              epoll_node_teardown(eph, epn);
+              list_delete(&epn->node);
               list_add_tail(&eph->oneshot, &epn->node);
             }
-          else
+          else if ((epn->pfd.events & EPOLLET) == 0)
             {
+              epoll_node_teardown(eph, epn);
+              list_delete(&epn->node);
               list_add_tail(&eph->teardown, &epn->node);
             }
         }
-      else
-        {
-          list_add_tail(&eph->teardown, &epn->node);
-        }
+
+      flags = spin_lock_irqsave(&eph->rlock);
+    }
+
+  more = !list_is_empty(&eph->ready);
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  /* Let the next epoll_wait() return at once if more fd are ready */
+
+  if (more)
+    {
+      epoll_post(eph);
     }
 
   nxmutex_unlock(&eph->lock);
@@ -402,16 +479,39 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
-  int semcount = 0;
+  FAR epoll_head_t *eph = epn->eph;
+  pollevent_t revents;
+  irqstate_t flags;
+
+  /* Move the events into the node, epoll_teardown() consumes them under
+   * the same lock.  fds->revents is only touched by poll_notify() then,
+   * so no event is lost to a concurrent teardown.
+   */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  revents       = fds->revents;
+  fds->revents  = 0;
+  epn->revents |= revents;
+  if ((epn->revents & (POLLERR | POLLHUP)) != 0)
+    {
+      /* Error or Hung up, clear POLLOUT event */
+
+      epn->revents &= ~POLLOUT;
+    }
+
+  /* Queue the fd in the ready list, once */
 
-  epn->notified = true;
-  if (fds->revents != 0)
+  if (revents != 0 && !epn->notified)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
-      if (semcount < 1)
-        {
-          nxsem_post(&epn->eph->sem);
-        }
+      epn->notified = true;
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (revents != 0)
+    {
+      epoll_post(eph);
     }
 }
 
@@ -562,6 +662,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn->eph         = eph;
         epn->data        = ev->data;
         epn->notified    = false;
+        epn->revents     = 0;
         epn->pfd.events  = ev->events | POLLALWAYS;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
@@ -592,7 +693,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                file_poll(epn->filep, &epn->pfd, false);
+                epoll_node_teardown(eph, epn);
                 file_put(epn->filep);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
@@ -632,10 +733,10 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
               {
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
-                    file_poll(epn->filep, &epn->pfd, false);
+                    epoll_node_teardown(eph, epn);
 
-                    epn->notified    = false;
                     epn->data        = ev->data;
+                    epn->revents     = 0;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.revents = 0;
 
@@ -656,8 +757,8 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
               {
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
-                    epn->notified    = false;
                     epn->data        = ev->data;
+                    epn->revents     = 0;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.revents = 0;
 
@@ -679,8 +780,8 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                epn->notified    = false;
                 epn->data        = ev->data;
+                epn->revents     = 0;
                 epn->pfd.events  = ev->events | POLLALWAYS;
                 epn->pfd.revents = 0;
 
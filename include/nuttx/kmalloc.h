@@ -84,6 +84,9 @@ extern "C"
 #define kumm_free(p)             free(p)
 #define kumm_mallinfo()          mallinfo()
 
+#define kumm_malloc_zone(z,s)    mm_zone_malloc(USR_HEAP,z,s)
+#define kumm_memalign_zone(z,a,s) mm_zone_memalign(USR_HEAP,z,a,s)
+
 /* This family of allocators is used to manage kernel protected memory */
 
 #ifndef CONFIG_MM_KERNEL_HEAP
@@ -105,12 +108,17 @@ extern "C"
 #  define kmm_mallinfo()         mallinfo()
 #  define kmm_heapmember(p)      umm_heapmember(p)
 #  define kmm_memdump(p)         umm_memdump(p)
+#  define kmm_malloc_zone(z,s)   kumm_malloc_zone(z,s)
+#  define kmm_memalign_zone(z,a,s) kumm_memalign_zone(z,a,s)
 
 #else
 /* Otherwise, the kernel-space allocators are declared in
  * include/nuttx/mm/mm.h and we can call them directly.
  */
 
+#  define kmm_malloc_zone(z,s)   mm_zone_malloc(g_kmmheap,z,s)
+#  define kmm_memalign_zone(z,a,s) mm_zone_memalign(g_kmmheap,z,a,s)
+
 #endif
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -32,6 +32,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <nuttx/atomic.h>
+
 #ifdef CONFIG_IOB_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -72,6 +74,17 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* The large I/O buffers must be larger than the normal ones */
+
+#if !defined(CONFIG_IOB_LARGE_NBUFFERS)
+#  define CONFIG_IOB_LARGE_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0 && \
+    CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#endif
+
 /* Default config of alignment and head padding size */
 
 #if !defined(CONFIG_IOB_ALIGNMENT)
@@ -81,7 +94,7 @@
 /* IOB helpers */
 
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -102,6 +115,14 @@
 
 typedef CODE void (*iob_free_cb_t)(FAR void *data);
 
+/* Copies 'len' bytes from 'src' to 'dest' like memcpy(), and may process
+ * the data on the way, e.g. compute its checksum.
+ */
+
+typedef CODE void (*iob_copy_cb_t)(FAR uint8_t *dest,
+                                   FAR const uint8_t *src,
+                                   unsigned int len, FAR void *arg);
+
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
@@ -135,6 +156,21 @@ struct iob_s
 #endif
 };
 
+#ifdef CONFIG_IOB_ALLOC
+/* A reference counted external buffer, e.g. file data mapped in memory.
+ * Each I/O buffer attached to it by iob_alloc_with_ref() holds one
+ * reference; ref_release is called with ref_arg when the last reference
+ * is dropped by iob_ref_put().
+ */
+
+struct iob_ref_s
+{
+  atomic_t      ref_count;   /* Number of references */
+  iob_free_cb_t ref_release; /* Called when the last reference is dropped */
+  FAR void     *ref_arg;     /* Argument of ref_release */
+};
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* This container structure supports queuing of I/O buffer chains.  This
  * structure is intended only for internal use by the IOB module.
@@ -221,6 +257,50 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_hint
+ *
+ * Description:
+ *   Allocate an I/O buffer for size bytes of data.  A large I/O buffer is
+ *   taken when the size is beyond CONFIG_IOB_BUFSIZE and one is free,
+ *   otherwise this is the same as iob_alloc().
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+FAR struct iob_s *iob_alloc_hint(bool throttled, unsigned int size);
+#else
+#  define iob_alloc_hint(throttled, size) iob_alloc(throttled)
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_hint
+ *
+ * Description:
+ *   Try to allocate an I/O buffer for size bytes of data without waiting.
+ *   A large I/O buffer is taken when the size is beyond CONFIG_IOB_BUFSIZE
+ *   and one is free, otherwise this is the same as iob_tryalloc().
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+FAR struct iob_s *iob_tryalloc_hint(bool throttled, unsigned int size);
+#else
+#  define iob_tryalloc_hint(throttled, size) iob_tryalloc(throttled)
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Try to allocate a chain of count I/O buffers with one acquisition of
+ *   the IOB lock, without waiting for buffers to become free.  Either all
+ *   of the I/O buffers are allocated or none.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(bool throttled, unsigned int count);
+
 #ifdef CONFIG_IOB_ALLOC
 /****************************************************************************
  * Name: iob_alloc_dynamic
@@ -266,6 +346,54 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size);
 
 FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
                                       iob_free_cb_t free_cb);
+
+/****************************************************************************
+ * Name: iob_ref_init
+ *
+ * Description:
+ *   Initialize a reference counted external buffer.  The caller holds the
+ *   first reference and drops it with iob_ref_put() when it is done
+ *   attaching the buffer to I/O buffers.
+ *
+ * Input Parameters:
+ *   ref     - The reference counted buffer
+ *   release - Called with 'arg' when the last reference is dropped
+ *   arg     - The argument of 'release'
+ *
+ ****************************************************************************/
+
+void iob_ref_init(FAR struct iob_ref_s *ref, iob_free_cb_t release,
+                  FAR void *arg);
+
+/****************************************************************************
+ * Name: iob_ref_put
+ *
+ * Description:
+ *   Drop a reference to an external buffer.
+ *
+ ****************************************************************************/
+
+void iob_ref_put(FAR struct iob_ref_s *ref);
+
+/****************************************************************************
+ * Name: iob_alloc_with_ref
+ *
+ * Description:
+ *   Allocate an I/O buffer from heap whose io_data points into a reference
+ *   counted external buffer.  The I/O buffer holds a reference until it is
+ *   freed, so the external buffer outlives all the packets built on it.
+ *   The data is never written through the I/O buffer.
+ *
+ * Input Parameters:
+ *   data - The data in the external buffer
+ *   size - The size of the data, which becomes the length of the I/O
+ *          buffer
+ *   ref  - The reference counted external buffer
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_with_ref(FAR const void *data, uint16_t size,
+                                     FAR struct iob_ref_s *ref);
 #endif
 
 /****************************************************************************
@@ -347,7 +475,8 @@ void iob_notifier_teardown(int key);
  *
  * Description:
  *   Free an entire buffer chain, starting at the beginning of the I/O
- *   buffer chain
+ *   buffer chain.  All of the I/O buffers are returned with one acquisition
+ *   of the IOB lock.
  *
  ****************************************************************************/
 
@@ -476,6 +605,20 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled);
 
+/****************************************************************************
+ * Name: iob_copyin_cb
+ *
+ * Description:
+ *  Like iob_copyin(), or iob_trycopyin() if 'can_block' is false, but copy
+ *  each contiguous part of the data with copy(dest, src, n, arg).  The
+ *  parts are copied in order.
+ *
+ ****************************************************************************/
+
+int iob_copyin_cb(FAR struct iob_s *iob, FAR const uint8_t *src,
+                  unsigned int len, int offset, bool throttled,
+                  bool can_block, iob_copy_cb_t copy, FAR void *arg);
+
 /****************************************************************************
  * Name: iob_copyout
  *
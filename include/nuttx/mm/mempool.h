@@ -29,6 +29,7 @@
 
 #include <sys/types.h>
 
+#include <nuttx/atomic.h>
 #include <nuttx/list.h>
 #include <nuttx/queue.h>
 #include <nuttx/mm/mm.h>
@@ -87,6 +88,16 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+/* This structure describes the per-CPU free block cache of a mempool */
+
+struct mempool_percpu_s
+{
+  FAR sq_entry_t *head;  /* The free block list cached by this CPU */
+  size_t          count; /* The number of blocks in the free block list */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -100,6 +111,9 @@ struct mempool_s
   mempool_alloc_t alloc;    /* The alloc function for mempool */
   mempool_free_t  free;     /* The free function for mempool */
   mempool_check_t check;    /* The check function for mempool */
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  bool       percpu;        /* The flag of cache free blocks for every CPU */
+#endif
 
   /* Private data for memory pool */
 
@@ -107,9 +121,16 @@ struct mempool_s
   sq_queue_t queue;   /* The free block queue in normal mempool */
   sq_queue_t iqueue;  /* The free block queue in interrupt mempool */
   sq_queue_t equeue;  /* The expand block queue for normal mempool */
-  size_t     nalloc;  /* The number of used block in mempool */
+  atomic_t   nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  atomic64_t lfhead;  /* The tagged head of lock-free free block stack */
+  size_t     nblocks; /* The number of blocks in normal mempool */
+#endif
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  struct mempool_percpu_s cache[CONFIG_SMP_NCPUS]; /* Per-CPU free blocks */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -137,6 +158,7 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+  unsigned long ncached;  /* This is the number of blocks cached by CPUs */
 };
 
 /****************************************************************************
@@ -166,6 +166,30 @@
 #define MM_ALLOC_MAGIC   0xaa
 #define MM_FREE_MAGIC    0x55
 
+/* Number of log2 buckets of the heap statistics histograms.  Bucket n
+ * counts the values in [2^(n-1), 2^n), the last bucket also holds all
+ * the larger values.
+ */
+
+#define MM_STAT_NBUCKETS 32
+
+/* Heap zones.  A zone is a heap of its own registered with a home heap,
+ * i.e. the user or the kernel heap, with mm_zone_register().  The home
+ * heap itself is the normal zone.  The zone argument of the mm_zone_*()
+ * allocators is one of the zones below optionally or-ed with
+ * MM_ZONE_STRICT.  Without MM_ZONE_STRICT an allocation that does not fit
+ * in the requested zone falls back to the normal zone.
+ */
+
+#define MM_ZONE_DEFAULT  0x00 /* Default zone of the calling task */
+#define MM_ZONE_NORMAL   0x01 /* General purpose memory, the home heap */
+#define MM_ZONE_FAST     0x02 /* Fast on-chip memory, SRAM, TCM, ... */
+#define MM_ZONE_MASK     0x0f
+#define MM_ZONE_STRICT   0x10 /* Fail rather than fall back */
+
+#define MM_NZONES        2
+#define MM_ZONE_INDEX(z) (((z) & MM_ZONE_MASK) - 1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -182,6 +206,32 @@ struct mempool_init_s
   size_t            dict_expendsize;
 };
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+/* Fragmentation and latency statistics of one heap */
+
+struct mm_heapstat_s
+{
+  size_t        largest;                    /* Largest free chunk now */
+  size_t        minlargest;                 /* Lowest largest chunk seen */
+  unsigned long freehist[MM_STAT_NBUCKETS]; /* Free chunks by size */
+  unsigned long mallocs[MM_STAT_NBUCKETS];  /* mm_malloc() cycles */
+  unsigned long frees[MM_STAT_NBUCKETS];    /* mm_free() cycles */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_ZONES
+/* Usage of one zone of a home heap, see mm_zoneinfo() */
+
+struct mm_zoneinfo_s
+{
+  FAR struct mm_heap_s *home;      /* Home heap of the zone */
+  FAR struct mm_heap_s *heap;      /* Heap backing the zone */
+  int                   zone;      /* MM_ZONE_NORMAL, MM_ZONE_FAST, ... */
+  unsigned long         allocs;    /* Allocations served by the zone */
+  unsigned long         fallbacks; /* Allocations that did not fit */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -411,6 +461,43 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 size_t mm_heapfree(FAR struct mm_heap_s *heap);
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap);
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+void mm_heapstat(FAR struct mm_heap_s *heap,
+                 FAR struct mm_heapstat_s *stat);
+#endif
+
+/* Functions contained in mm_zone.c *****************************************/
+
+#ifdef CONFIG_MM_HEAP_ZONES
+int mm_zone_register(FAR struct mm_heap_s *home, int zone,
+                     FAR struct mm_heap_s *heap);
+FAR struct mm_heap_s *mm_zone_heap(FAR struct mm_heap_s *home,
+                                   FAR void *mem);
+FAR void *mm_zone_malloc(FAR struct mm_heap_s *home, int zone, size_t size)
+  malloc_like1(3);
+FAR void *mm_zone_memalign(FAR struct mm_heap_s *home, int zone,
+                           size_t alignment, size_t size) malloc_like1(4);
+FAR void *mm_zone_zalloc(FAR struct mm_heap_s *home, int zone, size_t size)
+  malloc_like1(3);
+FAR void *mm_zone_calloc(FAR struct mm_heap_s *home, int zone, size_t n,
+                         size_t elem_size) malloc_like2(3, 4);
+FAR void *mm_zone_realloc(FAR struct mm_heap_s *home, FAR void *oldmem,
+                          size_t size) realloc_like(3);
+int mm_zone_settask(pid_t pid, int zone);
+int mm_zone_gettask(pid_t pid);
+int mm_zoneinfo(int index, FAR struct mm_zoneinfo_s *info);
+#else
+#  define mm_zone_heap(home, mem)          (home)
+#  define mm_zone_malloc(home, zone, size) mm_malloc(home, size)
+#  define mm_zone_memalign(home, zone, alignment, size) \
+          mm_memalign(home, alignment, size)
+#  define mm_zone_zalloc(home, zone, size) mm_zalloc(home, size)
+#  define mm_zone_calloc(home, zone, n, elem_size) \
+          mm_calloc(home, n, elem_size)
+#  define mm_zone_realloc(home, oldmem, size) \
+          mm_realloc(home, oldmem, size)
+#endif
+
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
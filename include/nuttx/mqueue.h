@@ -115,6 +115,9 @@ struct mqueue_inode_s
   struct mqueue_cmn_s cmn;    /* Common prologue */
   FAR struct inode *inode;    /* Containing inode */
   struct list_node msglist;   /* Prioritized message list */
+#ifdef CONFIG_MQ_SLAB
+  struct list_node msgfree;   /* Free messages of the queue's own slab */
+#endif
   int16_t maxmsgs;            /* Maximum number of messages in the queue */
   int16_t nmsgs;              /* Number of message in the queue */
 #if CONFIG_MQ_MAXMSGSIZE < 256
@@ -793,6 +796,88 @@ int file_mq_setattr(FAR struct file *mq, FAR const struct mq_attr *mq_stat,
 
 int file_mq_getattr(FAR struct file *mq, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_LOAN
+/****************************************************************************
+ * Name: file_mq_loan
+ *
+ * Description:
+ *   Borrow a message buffer of the message queue "mq".  The caller fills
+ *   the buffer in place and passes it to file_mq_loansend(), or gives it
+ *   back with file_mq_unloan().
+ *
+ * Input Parameters:
+ *   mq - Message queue descriptor
+ *
+ * Returned Value:
+ *   A buffer of the mq_msgsize attribute of the queue, or NULL if no
+ *   message could be allocated.
+ *
+ ****************************************************************************/
+
+FAR void *file_mq_loan(FAR struct file *mq);
+
+/****************************************************************************
+ * Name: file_mq_loansend
+ *
+ * Description:
+ *   Queue the borrowed buffer "buf" in the message queue "mq" without
+ *   copying it.  It behaves like file_mq_send() otherwise.
+ *
+ * Input Parameters:
+ *   mq     - Message queue descriptor
+ *   buf    - Buffer returned by file_mq_loan()
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; the buffer then belongs to the
+ *   message queue.  A negated errno value is returned on failure and the
+ *   buffer still belongs to the caller.
+ *
+ ****************************************************************************/
+
+int file_mq_loansend(FAR struct file *mq, FAR void *buf, size_t msglen,
+                     unsigned int prio);
+
+/****************************************************************************
+ * Name: file_mq_loanreceive
+ *
+ * Description:
+ *   Take the oldest message of highest priority from the message queue
+ *   "mq" without copying it.  It behaves like file_mq_receive() otherwise.
+ *   The buffer must be given back with file_mq_unloan().
+ *
+ * Input Parameters:
+ *   mq   - Message queue descriptor
+ *   buf  - Location to return the buffer holding the message
+ *   prio - If not NULL, location to return the priority of the message
+ *
+ * Returned Value:
+ *   The length of the message on success.  A negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_loanreceive(FAR struct file *mq, FAR void **buf,
+                            FAR unsigned int *prio);
+
+/****************************************************************************
+ * Name: file_mq_unloan
+ *
+ * Description:
+ *   Give back a buffer obtained from file_mq_loan() or
+ *   file_mq_loanreceive().  Buffers must be given back before the message
+ *   queue is closed.
+ *
+ * Input Parameters:
+ *   mq  - Message queue descriptor
+ *   buf - The borrowed buffer
+ *
+ ****************************************************************************/
+
+void file_mq_unloan(FAR struct file *mq, FAR void *buf);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
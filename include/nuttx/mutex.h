@@ -28,6 +28,7 @@
  ****************************************************************************/
 
 #include <assert.h>
+#include <errno.h>
 #include <stdbool.h>
 
 #include <nuttx/semaphore.h>
@@ -51,6 +52,10 @@ struct mutex_s
 #if CONFIG_LIBC_MUTEX_BACKTRACE > 0
   FAR void *backtrace[CONFIG_LIBC_MUTEX_BACKTRACE];
 #endif
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  uint32_t nlocks;      /* Number of times the mutex was taken */
+  uint32_t ncontended;  /* Number of times it was found locked */
+#endif
 };
 
 typedef struct mutex_s mutex_t;
@@ -96,6 +101,50 @@ void nxmutex_add_backtrace(FAR mutex_t *mutex);
 #  define nxmutex_add_backtrace(mutex)
 #endif
 
+/****************************************************************************
+ * Name: nxmutex_add_stats
+ *
+ * Description:
+ *   This function accounts a lock of the mutex in its statistics.  It is
+ *   called by the holder of the mutex, which protects the counters.
+ *
+ * Parameters:
+ *   mutex     - mutex descriptor.
+ *   contended - The mutex was found locked and had to be waited for.
+ *
+ * Return Value:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+void nxmutex_add_stats(FAR mutex_t *mutex, bool contended);
+#else
+#  define nxmutex_add_stats(mutex, contended)
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   This function returns the statistics of the mutex.  The counters are
+ *   read without taking the mutex, so the two values may be one lock apart
+ *   while another task holds it.
+ *
+ * Parameters:
+ *   mutex      - mutex descriptor.
+ *   nlocks     - Location to return the number of times the mutex was taken.
+ *   ncontended - Location to return the number of times the mutex was found
+ *                locked by another task.
+ *
+ * Return Value:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+void nxmutex_get_stats(FAR const mutex_t *mutex, FAR uint32_t *nlocks,
+                       FAR uint32_t *ncontended);
+#endif
+
 /****************************************************************************
  * Name: nxmutex_init
  *
@@ -503,12 +552,27 @@ static inline_function int nxmutex_destroy(FAR mutex_t *mutex)
 
 static inline_function int nxmutex_lock(FAR mutex_t *mutex)
 {
-  int ret;
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  bool contended;
+#endif
+  int ret = -EAGAIN;
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  /* Only a mutex found locked counts as contended */
+
+  ret       = nxsem_trywait(&mutex->sem);
+  contended = ret < 0;
+#endif
+
+  if (ret == -EAGAIN)
+    {
+      ret = nxsem_wait(&mutex->sem);
+    }
 
-  ret = nxsem_wait(&mutex->sem);
   if (ret >= 0)
     {
       nxmutex_add_backtrace(mutex);
+      nxmutex_add_stats(mutex, contended);
     }
 
   return ret;
@@ -543,6 +607,7 @@ static inline_function int nxmutex_trylock(FAR mutex_t *mutex)
   if (ret >= 0)
     {
       nxmutex_add_backtrace(mutex);
+      nxmutex_add_stats(mutex, false);
     }
 
   return ret;
@@ -380,6 +380,22 @@ int net_trylock(void);
 
 void net_unlock(void);
 
+/****************************************************************************
+ * Name: net_lock_held
+ *
+ * Description:
+ *   Check whether the calling thread holds the network lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   true if the calling thread holds the network lock.
+ *
+ ****************************************************************************/
+
+bool net_lock_held(void);
+
 /****************************************************************************
  * Name: net_sem_timedwait
  *
@@ -220,6 +220,16 @@
 #define NET_LL_HDRLEN(d)       ((d)->d_llhdrlen)
 #define NETDEV_PKTSIZE(d)      ((d)->d_pktsize)
 
+/* The segment size of a large TCP packet in the device buffer, zero if the
+ * packet is not larger than NETDEV_PKTSIZE().
+ */
+
+#ifdef CONFIG_NET_TCP_TSO
+#  define NETDEV_GSOSIZE(d)    ((d)->d_gsosize)
+#else
+#  define NETDEV_GSOSIZE(d)    0
+#endif
+
 #ifdef CONFIG_NET_ETHERNET
 #  define _MIN_ETH_PKTSIZE     CONFIG_NET_ETH_PKTSIZE
 #  define _MAX_ETH_PKTSIZE     CONFIG_NET_ETH_PKTSIZE
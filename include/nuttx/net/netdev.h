@@ -412,12 +412,38 @@ struct net_driver_s
 
   FAR struct iob_s *d_iob;
 
-  /* Remember the outgoing fragments waiting to be sent */
+  /* Remember the outgoing fragments or TCP segments waiting to be sent */
 
-#ifdef CONFIG_NET_IPFRAG
+#if defined(CONFIG_NET_IPFRAG) || defined(CONFIG_NET_TCP_TSO)
   FAR struct iob_queue_s d_fragout;
 #endif
 
+#ifdef CONFIG_NET_TCP_TSO
+  /* The largest IP packet carrying TCP that the driver segments itself,
+   * zero if the network must segment large TCP packets.  Set by the
+   * driver.
+   */
+
+  uint16_t d_tsomax;
+
+  /* The size of the segments to cut the TCP packet in d_iob into, zero
+   * if the packet is a single segment.
+   */
+
+  uint16_t d_gsosize;
+#endif
+
+#ifdef CONFIG_NETDEV_GRO
+  /* The TCP segments of a receive burst being coalesced by
+   * netdev_gro_receive(), the number of segments coalesced, and whether
+   * the TCP checksum of the packet in d_iob has already been verified.
+   */
+
+  FAR struct iob_s *d_gro;
+  uint8_t d_grosegs;
+  bool d_grochksum;
+#endif
+
   /* The d_buf array is used to hold incoming and outgoing packets. The
    * device driver should place incoming data into this buffer.  When sending
    * data, the device driver should read the link level headers and the
@@ -528,6 +554,15 @@ struct net_driver_s
   FAR struct devif_callback_s *d_conncb_tail; /* This is the list tail */
   FAR struct devif_callback_s *d_devcb;
 
+#ifdef CONFIG_NETDEV_TXREADY
+  /* The TCP and UDP connections with pending TX work on this device, the
+   * only ones that devif_poll() polls.
+   */
+
+  dq_queue_t d_tcpready;
+  dq_queue_t d_udpready;
+#endif
+
   /* Driver callbacks */
 
   CODE int (*d_ifup)(FAR struct net_driver_s *dev);
@@ -551,6 +586,7 @@ typedef CODE int (*devif_poll_callback_t)(FAR struct net_driver_s *dev);
 typedef CODE int (*devif_ipv6_callback_t)(FAR struct net_driver_s *dev,
                                           FAR struct netdev_ifaddr6_s *addr,
                                           FAR void *arg);
+typedef CODE void (*netdev_gro_input_t)(FAR struct net_driver_s *dev);
 
 /****************************************************************************
  * Public Function Prototypes
@@ -810,6 +846,34 @@ void netdev_carrier_off(FAR struct net_driver_s *dev);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy data and calculate its raw check sum in the same pass, e.g. as
+ *   the copy function of iob_copyin_cb().
+ *
+ *   This function is not available if CONFIG_NET_ARCH_CHKSUM is defined.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.  This
+ *          should be zero on the first call.
+ *   dest - Where to copy the data to.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data.
+ *   odd  - Whether the data of the previous calls had an odd length.
+ *          This should be false on the first call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd);
+#endif
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -1202,6 +1266,54 @@ void netdev_iob_release(FAR struct net_driver_s *dev);
 FAR struct iob_s *netdev_iob_clone(FAR struct net_driver_s *dev,
                                    bool throttled);
 
+/****************************************************************************
+ * Name: netdev_gro_receive
+ *
+ * Description:
+ *   Offer the frame in d_iob to the receive coalescing logic.  In-order
+ *   TCP data segments of the same IPv4 flow are chained behind the first
+ *   one and passed up the stack as a single segment, so that the
+ *   connection lookup, the socket callbacks and the ACK happen once per
+ *   burst instead of once per frame.
+ *
+ * Input Parameters:
+ *   dev   - The network device that received the frame
+ *   input - The function that passes a frame in d_iob up the stack
+ *
+ * Returned Value:
+ *   true if the frame was taken; d_iob is then cleared.  false if the
+ *   frame must be passed up the stack by the caller, which is done after
+ *   any held segments.
+ *
+ * Assumptions:
+ *   The caller has locked the network and calls netdev_gro_flush() at the
+ *   end of the burst.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GRO
+bool netdev_gro_receive(FAR struct net_driver_s *dev,
+                        netdev_gro_input_t input);
+
+/****************************************************************************
+ * Name: netdev_gro_flush
+ *
+ * Description:
+ *   Pass the segments held by netdev_gro_receive() up the stack.
+ *
+ * Input Parameters:
+ *   dev   - The network device
+ *   input - The function that passes a frame in d_iob up the stack
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+void netdev_gro_flush(FAR struct net_driver_s *dev,
+                      netdev_gro_input_t input);
+#endif
+
 /****************************************************************************
  * Name: netdev_ipv6_add/del
  *
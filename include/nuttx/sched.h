@@ -557,6 +557,11 @@ struct task_group_s
  * definitions.
  */
 
+#ifdef CONFIG_MQ_HANDOFF
+struct mqueue_rcvbuf_s;             /* Forward reference */
+                                    /* Defined in sched/mqueue/mqueue.h */
+#endif
+
 struct tcb_s
 {
   /* Fields used to support list management *********************************/
@@ -601,6 +606,10 @@ struct tcb_s
 
   uint8_t  task_state;                   /* Current state of the thread     */
 
+#ifdef CONFIG_MM_HEAP_ZONES
+  uint8_t  mm_zone;                      /* Default heap zone (MM_ZONE_*)   */
+#endif
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t  boost_priority;               /* Boosted priority of the thread  */
   uint8_t  base_priority;                /* Normal priority of the thread   */
@@ -648,6 +657,9 @@ struct tcb_s
   /* POSIX Semaphore and Message Queue Control Fields ***********************/
 
   FAR void *waitobj;                     /* Object thread waiting on        */
+#ifdef CONFIG_MQ_HANDOFF
+  FAR struct mqueue_rcvbuf_s *mqrcvbuf;  /* Buffer for a direct hand-off   */
+#endif
 
   /* POSIX Signal Control Fields ********************************************/
 
@@ -845,6 +857,7 @@ EXTERN clock_t g_preemp_max[CONFIG_SMP_NCPUS];
 
 #if CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0
 EXTERN clock_t g_crit_max[CONFIG_SMP_NCPUS];
+EXTERN uint64_t g_crit_total[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
 
 /* g_running_tasks[] holds a references to the running task for each CPU.
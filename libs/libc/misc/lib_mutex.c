@@ -62,6 +62,59 @@ void nxmutex_add_backtrace(FAR mutex_t *mutex)
 }
 #endif
 
+/****************************************************************************
+ * Name: nxmutex_add_stats
+ *
+ * Description:
+ *   This function accounts a lock of the mutex in its statistics.  It is
+ *   called by the holder of the mutex, which protects the counters.
+ *
+ * Parameters:
+ *   mutex     - mutex descriptor.
+ *   contended - The mutex was found locked and had to be waited for.
+ *
+ * Return Value:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+void nxmutex_add_stats(FAR mutex_t *mutex, bool contended)
+{
+  mutex->nlocks++;
+  if (contended)
+    {
+      mutex->ncontended++;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   This function returns the statistics of the mutex.  The counters are
+ *   read without taking the mutex, so the two values may be one lock apart
+ *   while another task holds it.
+ *
+ * Parameters:
+ *   mutex      - mutex descriptor.
+ *   nlocks     - Location to return the number of times the mutex was taken.
+ *   ncontended - Location to return the number of times the mutex was found
+ *                locked by another task.
+ *
+ * Return Value:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+void nxmutex_get_stats(FAR const mutex_t *mutex, FAR uint32_t *nlocks,
+                       FAR uint32_t *ncontended)
+{
+  *nlocks     = mutex->nlocks;
+  *ncontended = mutex->ncontended;
+}
+#endif
+
 /****************************************************************************
  * Name: nxmutex_init
  *
@@ -145,22 +198,36 @@ bool nxmutex_is_hold(FAR mutex_t *mutex)
 
 int nxmutex_ticklock(FAR mutex_t *mutex, uint32_t delay)
 {
-  int ret;
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  bool contended;
+#endif
+  int ret = -EAGAIN;
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  /* Only a mutex found locked counts as contended */
+
+  ret       = nxsem_trywait(&mutex->sem);
+  contended = ret < 0;
+#endif
 
   /* Wait until we get the lock or until the timeout expires */
 
-  if (delay)
-    {
-      ret = nxsem_tickwait(&mutex->sem, delay);
-    }
-  else
+  if (ret == -EAGAIN)
     {
-      ret = nxsem_trywait(&mutex->sem);
+      if (delay)
+        {
+          ret = nxsem_tickwait(&mutex->sem, delay);
+        }
+      else
+        {
+          ret = nxsem_trywait(&mutex->sem);
+        }
     }
 
   if (ret >= 0)
     {
       nxmutex_add_backtrace(mutex);
+      nxmutex_add_stats(mutex, contended);
     }
 
   return ret;
@@ -194,22 +261,36 @@ int nxmutex_ticklock(FAR mutex_t *mutex, uint32_t delay)
 int nxmutex_clocklock(FAR mutex_t *mutex, clockid_t clockid,
                       FAR const struct timespec *abstime)
 {
-  int ret;
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  bool contended;
+#endif
+  int ret = -EAGAIN;
+
+#ifdef CONFIG_LIBC_MUTEX_STATISTICS
+  /* Only a mutex found locked counts as contended */
+
+  ret       = nxsem_trywait(&mutex->sem);
+  contended = ret < 0;
+#endif
 
   /* Wait until we get the lock or until the timeout expires */
 
-  if (abstime)
+  if (ret == -EAGAIN)
     {
-      ret = nxsem_clockwait(&mutex->sem, clockid, abstime);
-    }
-  else
-    {
-      ret = nxsem_wait(&mutex->sem);
+      if (abstime)
+        {
+          ret = nxsem_clockwait(&mutex->sem, clockid, abstime);
+        }
+      else
+        {
+          ret = nxsem_wait(&mutex->sem);
+        }
     }
 
   if (ret >= 0)
     {
       nxmutex_add_backtrace(mutex);
+      nxmutex_add_stats(mutex, contended);
     }
 
   return ret;
@@ -51,6 +51,59 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* The pre-allocated large I/O buffers are told apart by their payload
+ * size, the dynamic ones must have been checked by io_free before.
+ */
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_IS_LARGE(iob) ((iob)->io_bufsize == CONFIG_IOB_LARGE_BUFSIZE)
+#endif
+
+/* The I/O buffers referencing external data are read-only */
+
+#ifdef CONFIG_IOB_ALLOC
+#  define IOB_IS_READONLY(iob) ((iob)->io_free == iob_ref_free)
+#else
+#  define IOB_IS_READONLY(iob) false
+#endif
+
+/* The per-CPU caches exchange I/O buffers with the free list in batches
+ * of half the cache size.
+ */
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+#  define IOB_PERCPU_BATCH       ((CONFIG_IOB_PERCPU_CACHE + 1) / 2)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* The free I/O buffers cached by one CPU.  The lock is uncontended but
+ * for iob_percpu_drain(), which empties the caches of all CPUs.
+ */
+
+struct iob_percpu_s
+{
+  spinlock_t lock;               /* Protects the fields below */
+  FAR struct iob_s *head;        /* The list of cached I/O buffers */
+  int16_t count;                 /* The number of cached I/O buffers */
+};
+#endif
+
+#ifdef CONFIG_IOB_ALLOC
+/* An I/O buffer allocated by iob_alloc_with_ref(), told apart by its
+ * io_free callback iob_ref_free().
+ */
+
+struct iob_refiob_s
+{
+  struct iob_s iob;              /* The I/O buffer */
+  FAR struct iob_ref_s *ref;     /* The external buffer it references */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -98,10 +151,53 @@ extern int16_t g_qentry_wait;
 
 extern volatile spinlock_t g_iob_lock;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+extern FAR struct iob_s *g_iob_largelist;
+
+/* Counts free large I/O buffers */
+
+extern int16_t g_iob_large_count;
+#endif
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* The free I/O buffers cached by each CPU */
+
+extern struct iob_percpu_s g_iob_percpu[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_ref_free
+ *
+ * Description:
+ *   The io_free callback of the I/O buffers allocated by
+ *   iob_alloc_with_ref().  It is never called, iob_free_external() drops
+ *   the reference instead.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+void iob_ref_free(FAR void *data);
+#endif
+
+/****************************************************************************
+ * Name: iob_free_external
+ *
+ * Description:
+ *   Free an I/O buffer allocated from the heap, i.e. one with an io_free
+ *   callback, and release its payload.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+void iob_free_external(FAR struct iob_s *iob);
+#endif
+
 /****************************************************************************
  * Name: iob_alloc_qentry
  *
@@ -137,6 +233,50 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Return a list of count pre-allocated I/O buffers, linked from head to
+ *   tail, to the free or the committed list with one acquisition of the
+ *   IOB lock.  This function is intended only for internal use by the IOB
+ *   module.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *head, FAR struct iob_s *tail,
+                   int16_t count);
+
+/****************************************************************************
+ * Name: iob_free_large
+ *
+ * Description:
+ *   Return a list of count large I/O buffers, linked from head to tail, to
+ *   the large free list.  This function is intended only for internal use
+ *   by the IOB module.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+void iob_free_large(FAR struct iob_s *head, FAR struct iob_s *tail,
+                    int16_t count);
+#endif
+
+/****************************************************************************
+ * Name: iob_percpu_drain
+ *
+ * Description:
+ *   Return the free I/O buffers held by the caches of all CPUs to the free
+ *   or the committed list, so that they reach the allocators about to
+ *   block.  This function is intended only for internal use by the IOB
+ *   module.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+void iob_percpu_drain(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -142,6 +142,101 @@ static FAR struct iob_s *iob_tryalloc_internal(bool throttled)
   return NULL;
 }
 
+/****************************************************************************
+ * Name: iob_percpu_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU.  Only the lock
+ *   of this cache is taken, the IOB lock is taken once per batch to refill
+ *   an empty cache from the free list.  The refill never takes the I/O
+ *   buffers reserved by the throttle.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+static FAR struct iob_s *iob_percpu_alloc(void)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &g_iob_percpu[this_cpu()];
+  spin_lock(&cache->lock);
+  if (cache->count == 0)
+    {
+      spin_lock(&g_iob_lock);
+      while (cache->count < IOB_PERCPU_BATCH &&
+             g_iob_count > CONFIG_IOB_THROTTLE && g_iob_freelist != NULL)
+        {
+          iob            = g_iob_freelist;
+          g_iob_freelist = iob->io_flink;
+          g_iob_count--;
+
+          iob->io_flink  = cache->head;
+          cache->head    = iob;
+          cache->count++;
+        }
+
+      spin_unlock(&g_iob_lock);
+    }
+
+  iob = cache->head;
+  if (iob != NULL)
+    {
+      cache->head = iob->io_flink;
+      cache->count--;
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  spin_unlock(&cache->lock);
+  up_irq_restore(flags);
+  return iob;
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_large
+ *
+ * Description:
+ *   Try to allocate a large I/O buffer by taking the buffer at the head of
+ *   the large free list.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static FAR struct iob_s *iob_tryalloc_large(void)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_iob_lock);
+
+  iob = g_iob_largelist;
+  if (iob != NULL)
+    {
+      g_iob_largelist = iob->io_flink;
+      g_iob_large_count--;
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  spin_unlock_irqrestore(&g_iob_lock, flags);
+  return iob;
+}
+#endif
+
 /****************************************************************************
  * Name: iob_allocwait
  *
@@ -159,6 +254,16 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
   clock_t start;
   int ret = OK;
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Try the cache of this CPU first */
+
+  iob = iob_percpu_alloc();
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore to wait. */
 
@@ -193,6 +298,15 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
 
       spin_unlock_irqrestore(&g_iob_lock, flags);
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+      /* Now that we are counted as a waiter, the I/O buffers freed by the
+       * other CPUs bypass their caches.  Return those already cached, they
+       * are committed to us or to the waiters ahead of us.
+       */
+
+      iob_percpu_drain();
+#endif
+
       if (timeout == UINT_MAX)
         {
           ret = nxsem_wait_uninterruptible(sem);
@@ -300,6 +414,16 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   FAR struct iob_s *iob;
   irqstate_t flags;
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Try the cache of this CPU first */
+
+  iob = iob_percpu_alloc();
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
   /* We don't know what context we are called from so we use extreme measures
    * to protect the free list:  We disable interrupts very briefly.
    */
@@ -310,6 +434,110 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   return iob;
 }
 
+/****************************************************************************
+ * Name: iob_alloc_hint
+ *
+ * Description:
+ *   Allocate an I/O buffer for size bytes of data.  A large I/O buffer is
+ *   taken when the size is beyond CONFIG_IOB_BUFSIZE and one is free,
+ *   otherwise this is the same as iob_alloc().
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+FAR struct iob_s *iob_alloc_hint(bool throttled, unsigned int size)
+{
+  FAR struct iob_s *iob;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large();
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+
+  return iob_alloc(throttled);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_hint
+ *
+ * Description:
+ *   Try to allocate an I/O buffer for size bytes of data without waiting.
+ *   A large I/O buffer is taken when the size is beyond CONFIG_IOB_BUFSIZE
+ *   and one is free, otherwise this is the same as iob_tryalloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_hint(bool throttled, unsigned int size)
+{
+  FAR struct iob_s *iob;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large();
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+
+  return iob_tryalloc(throttled);
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Try to allocate a chain of count I/O buffers with one acquisition of
+ *   the IOB lock, without waiting for buffers to become free.  Either all
+ *   of the I/O buffers are allocated or none.
+ *
+ * Input Parameters:
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *   count     - The number of I/O buffers in the chain
+ *
+ * Returned Value:
+ *   The head of the chain, or NULL if not enough I/O buffers are free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(bool throttled, unsigned int count)
+{
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int avail;
+
+  flags = spin_lock_irqsave(&g_iob_lock);
+
+  avail = g_iob_count;
+#if CONFIG_IOB_THROTTLE > 0
+  if (throttled)
+    {
+      avail -= CONFIG_IOB_THROTTLE;
+    }
+#endif
+
+  if (count > 0 && avail >= (int)count)
+    {
+      while (count-- > 0)
+        {
+          iob = iob_tryalloc_internal(false);
+          DEBUGASSERT(iob != NULL);
+
+          iob->io_flink = head;
+          head          = iob;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_iob_lock, flags);
+  return head;
+}
+
 #ifdef CONFIG_IOB_ALLOC
 
 /****************************************************************************
@@ -396,4 +624,76 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
 
   return iob;
 }
+
+/****************************************************************************
+ * Name: iob_ref_free
+ *
+ * Description:
+ *   The io_free callback of the I/O buffers allocated by
+ *   iob_alloc_with_ref().  It is never called, iob_free_external() drops
+ *   the reference instead.
+ *
+ ****************************************************************************/
+
+void iob_ref_free(FAR void *data)
+{
+  DEBUGPANIC();
+}
+
+/****************************************************************************
+ * Name: iob_ref_init
+ *
+ * Description:
+ *   Initialize a reference counted external buffer.  The caller holds the
+ *   first reference and drops it with iob_ref_put() when it is done
+ *   attaching the buffer to I/O buffers.
+ *
+ ****************************************************************************/
+
+void iob_ref_init(FAR struct iob_ref_s *ref, iob_free_cb_t release,
+                  FAR void *arg)
+{
+  DEBUGASSERT(release != NULL);
+
+  atomic_set(&ref->ref_count, 1);
+  ref->ref_release = release;
+  ref->ref_arg     = arg;
+}
+
+/****************************************************************************
+ * Name: iob_alloc_with_ref
+ *
+ * Description:
+ *   Allocate an I/O buffer from heap whose io_data points into a reference
+ *   counted external buffer.  The I/O buffer holds a reference until it is
+ *   freed.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_with_ref(FAR const void *data, uint16_t size,
+                                     FAR struct iob_ref_s *ref)
+{
+  FAR struct iob_refiob_s *refiob;
+  FAR struct iob_s *iob;
+
+  refiob = kmm_malloc(sizeof(struct iob_refiob_s));
+  if (refiob == NULL)
+    {
+      return NULL;
+    }
+
+  atomic_fetch_add(&ref->ref_count, 1);
+  refiob->ref     = ref;
+
+  iob             = &refiob->iob;
+  iob->io_flink   = NULL;         /* Not in a chain */
+  iob->io_len     = size;         /* Length of the data in the entry */
+  iob->io_offset  = 0;            /* Offset to the beginning of data */
+  iob->io_bufsize = size;         /* Total length of the iob buffer */
+  iob->io_pktlen  = size;         /* Total length of the packet */
+  iob->io_free    = iob_ref_free; /* Drop the reference when freed */
+  iob->io_data    = (FAR uint8_t *)data;
+
+  return iob;
+}
 #endif
@@ -54,7 +54,8 @@
 
 static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
                                unsigned int len, int offset,
-                               bool throttled, bool can_block)
+                               bool throttled, bool can_block,
+                               iob_copy_cb_t copy, FAR void *arg)
 {
   FAR struct iob_s *head = iob;
   FAR struct iob_s *next;
@@ -161,7 +162,15 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       /* Copy from the user buffer to the I/O buffer.  */
 
-      memcpy(dest, src, ncopy);
+      if (copy != NULL)
+        {
+          copy(dest, src, ncopy, arg);
+        }
+      else
+        {
+          memcpy(dest, src, ncopy);
+        }
+
       iobinfo("iob=%p Copy %u bytes new len=%u\n",
               iob, ncopy, iob->io_len);
 
@@ -178,18 +187,18 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       if (len > 0 && !next)
         {
-          /* Yes.. allocate a new buffer.
+          /* Yes.. allocate a new buffer, a large one for bulk data.
            *
            * Copy as many bytes as possible. Block if we're allowed.
            */
 
           if (can_block)
             {
-              next = iob_alloc(throttled);
+              next = iob_alloc_hint(throttled, len);
             }
           else
             {
-              next = iob_tryalloc(throttled);
+              next = iob_tryalloc_hint(throttled, len);
             }
 
           if (next == NULL)
@@ -227,7 +236,8 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, true);
+  return iob_copyin_internal(iob, src, len, offset, throttled, true,
+                             NULL, NULL);
 }
 
 /****************************************************************************
@@ -243,5 +253,24 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, false);
+  return iob_copyin_internal(iob, src, len, offset, throttled, false,
+                             NULL, NULL);
+}
+
+/****************************************************************************
+ * Name: iob_copyin_cb
+ *
+ * Description:
+ *  Like iob_copyin(), or iob_trycopyin() if 'can_block' is false, but copy
+ *  each contiguous part of the data with copy(dest, src, n, arg).  The
+ *  parts are copied in order.
+ *
+ ****************************************************************************/
+
+int iob_copyin_cb(FAR struct iob_s *iob, FAR const uint8_t *src,
+                  unsigned int len, int offset, bool throttled,
+                  bool can_block, iob_copy_cb_t copy, FAR void *arg)
+{
+  return iob_copyin_internal(iob, src, len, offset, throttled, can_block,
+                             copy, arg);
 }
@@ -63,10 +63,305 @@
 
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_free_shared
+ *
+ * Description:
+ *   Return a list of I/O buffers to the free or the committed list.  We
+ *   don't know what context we are called from so we use extreme measures
+ *   to protect the free list:  We disable interrupts very briefly.
+ *
+ ****************************************************************************/
+
+static void iob_free_shared(FAR struct iob_s *head, FAR struct iob_s *tail,
+                            int16_t count)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int16_t nwait = 0;
+#if CONFIG_IOB_THROTTLE > 0
+  int16_t nthrottle = 0;
+#endif
+#ifdef CONFIG_IOB_NOTIFIER
+  int16_t nfreed = count;
+  int16_t navail;
+#endif
+
+  flags = spin_lock_irqsave(&g_iob_lock);
+
+  /* Which list?  If there is a task waiting for an IOB, then put
+   * the IOB on either the free list or on the committed list where
+   * it is reserved for that allocation (and not available to
+   * iob_tryalloc()). This is true for both throttled and non-throttled
+   * cases.
+   */
+
+  while (count > 0 && g_iob_count < 0)
+    {
+      iob             = head;
+      head            = iob->io_flink;
+      count--;
+
+      g_iob_count++;
+      iob->io_flink   = g_iob_committed;
+      g_iob_committed = iob;
+      nwait++;
+    }
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* The throttled waiters are served once the throttle reserve is full */
+
+  while (count > 0 && g_throttle_wait > 0)
+    {
+      iob             = head;
+      head            = iob->io_flink;
+      count--;
+
+      if (g_iob_count < CONFIG_IOB_THROTTLE)
+        {
+          g_iob_count++;
+          iob->io_flink   = g_iob_freelist;
+          g_iob_freelist  = iob;
+        }
+      else
+        {
+          iob->io_flink   = g_iob_committed;
+          g_iob_committed = iob;
+          g_throttle_wait--;
+          nthrottle++;
+        }
+    }
+#endif
+
+  if (count > 0)
+    {
+      g_iob_count    += count;
+      tail->io_flink  = g_iob_freelist;
+      g_iob_freelist  = head;
+    }
+
+  spin_unlock_irqrestore(&g_iob_lock, flags);
+
+  DEBUGASSERT(g_iob_count <= CONFIG_IOB_NBUFFERS);
+
+  /* Wake up the tasks that the committed I/O buffers are reserved for */
+
+  while (nwait-- > 0)
+    {
+      nxsem_post(&g_iob_sem);
+    }
+
+#if CONFIG_IOB_THROTTLE > 0
+  while (nthrottle-- > 0)
+    {
+      nxsem_post(&g_throttle_sem);
+    }
+#endif
+
+#ifdef CONFIG_IOB_NOTIFIER
+  /* Check if the IOB was claimed by a thread that is blocked waiting
+   * for an IOB.
+   */
+
+  navail = iob_navail(false);
+  if (navail > 0 && (navail & IOB_MASK) < nfreed)
+    {
+      /* Signal any threads that have requested a signal notification
+       * when an IOB becomes available.
+       */
+
+      iob_notifier_signal();
+    }
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_IOB_ALLOC
+/****************************************************************************
+ * Name: iob_ref_put
+ *
+ * Description:
+ *   Drop a reference to an external buffer.
+ *
+ ****************************************************************************/
+
+void iob_ref_put(FAR struct iob_ref_s *ref)
+{
+  if (atomic_fetch_sub(&ref->ref_count, 1) == 1)
+    {
+      ref->ref_release(ref->ref_arg);
+    }
+}
+
+/****************************************************************************
+ * Name: iob_free_external
+ *
+ * Description:
+ *   Free an I/O buffer allocated from the heap, i.e. one with an io_free
+ *   callback, and release its payload.
+ *
+ ****************************************************************************/
+
+void iob_free_external(FAR struct iob_s *iob)
+{
+  if (IOB_IS_READONLY(iob))
+    {
+      iob_ref_put(((FAR struct iob_refiob_s *)iob)->ref);
+    }
+  else
+    {
+      iob->io_free(iob->io_data);
+    }
+
+  kmm_free(iob);
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Return a list of count pre-allocated I/O buffers, linked from head to
+ *   tail, to the free or the committed list with one acquisition of the
+ *   IOB lock.
+ *
+ *   With the per-CPU caches, the list is put into the cache of the current
+ *   CPU instead and only the overflow goes to the free list.  The blocked
+ *   allocators are only served by the free list, so the cache is bypassed
+ *   once the free I/O buffers drop to the throttle reserve.  That is
+ *   checked under the cache lock: an allocator drains all caches after it
+ *   is counted as a waiter, so no freed buffer is stranded in a cache
+ *   while it sleeps.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *head, FAR struct iob_s *tail,
+                   int16_t count)
+{
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  FAR struct iob_percpu_s *cache;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &g_iob_percpu[this_cpu()];
+  spin_lock(&cache->lock);
+
+#  if CONFIG_IOB_THROTTLE > 0
+  if (g_iob_count > CONFIG_IOB_THROTTLE && g_throttle_wait == 0)
+#  else
+  if (g_iob_count > 0)
+#  endif
+    {
+      tail->io_flink = cache->head;
+      cache->head    = head;
+      cache->count  += count;
+
+      if (cache->count < CONFIG_IOB_PERCPU_CACHE)
+        {
+          spin_unlock(&cache->lock);
+          up_irq_restore(flags);
+          return;
+        }
+
+      /* Keep the cache half full and return the rest */
+
+      count = cache->count - (CONFIG_IOB_PERCPU_CACHE - IOB_PERCPU_BATCH);
+      head  = cache->head;
+      tail  = head;
+      while (--cache->count > CONFIG_IOB_PERCPU_CACHE - IOB_PERCPU_BATCH)
+        {
+          tail = tail->io_flink;
+        }
+
+      cache->head = tail->io_flink;
+    }
+
+  spin_unlock(&cache->lock);
+  up_irq_restore(flags);
+#endif
+
+  iob_free_shared(head, tail, count);
+}
+
+/****************************************************************************
+ * Name: iob_percpu_drain
+ *
+ * Description:
+ *   Return the free I/O buffers held by the caches of all CPUs to the free
+ *   or the committed list, so that they reach the allocators about to
+ *   block.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+void iob_percpu_drain(void)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *head;
+  FAR struct iob_s *tail;
+  irqstate_t flags;
+  int16_t count;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &g_iob_percpu[cpu];
+
+      flags = spin_lock_irqsave(&cache->lock);
+      head  = cache->head;
+      count = cache->count;
+
+      cache->head  = NULL;
+      cache->count = 0;
+      spin_unlock_irqrestore(&cache->lock, flags);
+
+      if (count > 0)
+        {
+          tail = head;
+          while (tail->io_flink != NULL)
+            {
+              tail = tail->io_flink;
+            }
+
+          iob_free_shared(head, tail, count);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_free_large
+ *
+ * Description:
+ *   Return a list of count large I/O buffers, linked from head to tail, to
+ *   the large free list.  Nobody waits for the large I/O buffers, their
+ *   allocation falls back to the normal ones.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+void iob_free_large(FAR struct iob_s *head, FAR struct iob_s *tail,
+                    int16_t count)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_iob_lock);
+  tail->io_flink     = g_iob_largelist;
+  g_iob_largelist    = head;
+  g_iob_large_count += count;
+  spin_unlock_irqrestore(&g_iob_lock, flags);
+
+  DEBUGASSERT(g_iob_large_count <= CONFIG_IOB_LARGE_NBUFFERS);
+}
+#endif
+
 /****************************************************************************
  * Name: iob_free
  *
@@ -79,10 +374,6 @@
 FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 {
   FAR struct iob_s *next = iob->io_flink;
-  irqstate_t flags;
-#ifdef CONFIG_IOB_NOTIFIER
-  int16_t navail;
-#endif
 
   iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
           iob, iob->io_pktlen, iob->io_len, next);
@@ -120,70 +411,24 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 #ifdef CONFIG_IOB_ALLOC
   if (iob->io_free != NULL)
     {
-      iob->io_free(iob->io_data);
-      kmm_free(iob);
+      iob_free_external(iob);
       return next;
     }
 #endif
 
-  /* Free the I/O buffer by adding it to the head of the free or the
-   * committed list. We don't know what context we are called from so
-   * we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
-   */
-
-  flags = spin_lock_irqsave(&g_iob_lock);
-
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()). This is true for both throttled and non-throttled
-   * cases.
-   */
-
-  if (g_iob_count < 0)
-    {
-      g_iob_count++;
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-      spin_unlock_irqrestore(&g_iob_lock, flags);
-      nxsem_post(&g_iob_sem);
-    }
-#if CONFIG_IOB_THROTTLE > 0
-  else if (g_throttle_wait > 0 && g_iob_count >= CONFIG_IOB_THROTTLE)
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  if (IOB_IS_LARGE(iob))
     {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-      g_throttle_wait--;
-      spin_unlock_irqrestore(&g_iob_lock, flags);
-      nxsem_post(&g_throttle_sem);
+      iob_free_large(iob, iob, 1);
+      return next;
     }
 #endif
-  else
-    {
-      g_iob_count++;
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
-      spin_unlock_irqrestore(&g_iob_lock, flags);
-    }
-
-  DEBUGASSERT(g_iob_count <= CONFIG_IOB_NBUFFERS);
 
-#ifdef CONFIG_IOB_NOTIFIER
-  /* Check if the IOB was claimed by a thread that is blocked waiting
-   * for an IOB.
+  /* Free the I/O buffer by adding it to the head of the free or the
+   * committed list.
    */
 
-  navail = iob_navail(false);
-  if (navail > 0 && (navail & IOB_MASK) == 0)
-    {
-      /* Signal any threads that have requested a signal notification
-       * when an IOB becomes available.
-       */
-
-      iob_notifier_signal();
-    }
-#endif
+  iob_free_list(iob, iob, 1);
 
   /* And return the I/O buffer after the one that was freed */
 
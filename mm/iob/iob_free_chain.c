@@ -46,12 +46,72 @@
 
 void iob_free_chain(FAR struct iob_s *iob)
 {
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
   FAR struct iob_s *next;
+  int16_t count = 0;
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  FAR struct iob_s *lhead = NULL;
+  FAR struct iob_s *ltail = NULL;
+  int16_t lcount = 0;
+#endif
 
-  /* Free each IOB in the chain -- one at a time to keep the count straight */
+  /* Collect the pre-allocated I/O buffers of the chain, so that they are
+   * returned with one acquisition of the IOB lock.
+   */
 
   for (; iob; iob = next)
     {
-      next = iob_free(iob);
+      next = iob->io_flink;
+
+#ifdef CONFIG_IOB_ALLOC
+      if (iob->io_free != NULL)
+        {
+          iob_free_external(iob);
+          continue;
+        }
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+      if (IOB_IS_LARGE(iob))
+        {
+          if (ltail == NULL)
+            {
+              lhead = iob;
+            }
+          else
+            {
+              ltail->io_flink = iob;
+            }
+
+          ltail = iob;
+          lcount++;
+          continue;
+        }
+#endif
+
+      if (tail == NULL)
+        {
+          head = iob;
+        }
+      else
+        {
+          tail->io_flink = iob;
+        }
+
+      tail = iob;
+      count++;
+    }
+
+  if (count > 0)
+    {
+      iob_free_list(head, tail, count);
+    }
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  if (lcount > 0)
+    {
+      iob_free_large(lhead, ltail, lcount);
     }
+#endif
 }
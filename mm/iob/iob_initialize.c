@@ -49,6 +49,15 @@
 #define IOB_BUFFER_SIZE   (IOB_ALIGN_SIZE * CONFIG_IOB_NBUFFERS + \
                            CONFIG_IOB_ALIGNMENT - 1)
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_LARGE_ALIGN_SIZE \
+     ALIGN_UP(ALIGN_UP(sizeof(struct iob_s), CONFIG_IOB_ALIGNMENT) + \
+              CONFIG_IOB_LARGE_BUFSIZE, CONFIG_IOB_ALIGNMENT)
+#  define IOB_LARGE_BUFFER_SIZE \
+     (IOB_LARGE_ALIGN_SIZE * CONFIG_IOB_LARGE_NBUFFERS + \
+      CONFIG_IOB_ALIGNMENT - 1)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -64,6 +73,19 @@ static uint8_t g_iob_buffer[IOB_BUFFER_SIZE] locate_data(IOB_SECTION);
 static uint8_t g_iob_buffer[IOB_BUFFER_SIZE];
 #endif
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* The raw buffer of the large I/O buffers, each payload follows its iob_s
+ * at the next CONFIG_IOB_ALIGNMENT boundary.
+ */
+
+#  ifdef IOB_SECTION
+static uint8_t g_iob_large_buffer[IOB_LARGE_BUFFER_SIZE]
+               locate_data(IOB_SECTION);
+#  else
+static uint8_t g_iob_large_buffer[IOB_LARGE_BUFFER_SIZE];
+#  endif
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* This is a pool of pre-allocated iob_qentry_s buffers */
 
@@ -92,6 +114,16 @@ FAR struct iob_qentry_s *g_iob_freeqlist;
 FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+FAR struct iob_s *g_iob_largelist;
+
+/* Counts free large I/O buffers */
+
+int16_t g_iob_large_count = CONFIG_IOB_LARGE_NBUFFERS;
+#endif
+
 sem_t g_iob_sem = SEM_INITIALIZER(0);
 
 /* Counting that tracks the number of free IOBs/qentries */
@@ -117,6 +149,12 @@ int16_t g_qentry_wait = 0;
 
 volatile spinlock_t g_iob_lock = SP_UNLOCKED;
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* The free I/O buffers cached by each CPU */
+
+struct iob_percpu_s g_iob_percpu[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -159,6 +197,23 @@ void iob_initialize(void)
       g_iob_freelist  = iob;
     }
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  /* Add each large I/O buffer to the head of the large free list */
+
+  buf = ALIGN_UP((uintptr_t)g_iob_large_buffer, CONFIG_IOB_ALIGNMENT);
+  for (i = 0; i < CONFIG_IOB_LARGE_NBUFFERS; i++)
+    {
+      FAR struct iob_s *iob =
+        (FAR struct iob_s *)(buf + i * IOB_LARGE_ALIGN_SIZE);
+
+      iob->io_flink   = g_iob_largelist;
+      iob->io_bufsize = CONFIG_IOB_LARGE_BUFSIZE;
+      iob->io_data    = (FAR uint8_t *)ALIGN_UP((uintptr_t)(iob + 1),
+                                                CONFIG_IOB_ALIGNMENT);
+      g_iob_largelist = iob;
+    }
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
   /* Add each I/O buffer chain queue container to the free list */
 
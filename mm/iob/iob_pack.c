@@ -70,6 +70,14 @@ FAR struct iob_s *iob_pack(FAR struct iob_s *iob)
     {
       next = iob->io_flink;
 
+      /* External data is not written, it stays where it is */
+
+      if (IOB_IS_READONLY(iob))
+        {
+          iob = next;
+          continue;
+        }
+
       /* Eliminate the data offset in this entry */
 
       if (iob->io_offset > 0)
@@ -79,11 +79,6 @@ int iob_update_pktlen(FAR struct iob_s *iob, unsigned int pktlen,
       next = next->io_flink;
     }
 
-  if (remain > 0)
-    {
-      nrequire += (remain + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE;
-    }
-
   if (nrequire == 0)
     {
       nrequire = 1;
@@ -117,19 +112,24 @@ int iob_update_pktlen(FAR struct iob_s *iob, unsigned int pktlen,
             }
         }
     }
-  else if (nrequire > ninqueue)
+  else if (remain > 0)
     {
       /* Start from the last IOB */
 
       next = penultimate;
 
-      /* Loop to extend the link */
+      /* Loop to extend the link, preferring large I/O buffers for the bulk
+       * of the remaining data.
+       */
 
-      while (next != NULL && nrequire > ninqueue)
+      while (next != NULL && remain > 0)
         {
-          next->io_flink = iob_tryalloc(throttled);
+          next->io_flink = iob_tryalloc_hint(throttled, remain);
           next = next->io_flink;
-          ninqueue++;
+          if (next != NULL)
+            {
+              remain -= IOB_BUFSIZE(next);
+            }
         }
     }
 
@@ -54,7 +54,7 @@
 
 bool kmm_heapmember(FAR void *mem)
 {
-  return mm_heapmember(g_kmmheap, mem);
+  return mm_heapmember(mm_zone_heap(g_kmmheap, mem), mem);
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
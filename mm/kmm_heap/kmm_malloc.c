@@ -50,7 +50,7 @@
 
 FAR void *kmm_malloc(size_t size)
 {
-  return mm_malloc(g_kmmheap, size);
+  return mm_zone_malloc(g_kmmheap, MM_ZONE_DEFAULT, size);
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -36,7 +36,7 @@
 
 size_t kmm_malloc_size(FAR void *mem)
 {
-  return mm_malloc_size(g_kmmheap, mem);
+  return mm_malloc_size(mm_zone_heap(g_kmmheap, mem), mem);
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
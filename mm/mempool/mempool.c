@@ -29,6 +29,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <syslog.h>
+#include <sys/param.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/kasan.h>
@@ -42,6 +43,44 @@
 
 #define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
 
+/* The number of blocks moved between the per-CPU cache and the shared free
+ * queue at once, half of the cache keeps both alloc and free bursts local.
+ */
+
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+#  define MEMPOOL_PERCPU_BATCH ((CONFIG_MM_MEMPOOL_PERCPU_CACHE + 1) / 2)
+#endif
+
+/* The lock-free free block stack keeps a generation tag above the block
+ * pointer in one 64-bit word, every successful update bumps the tag so a
+ * stale head can't be swapped back in (ABA).  On 64-bit targets the tag
+ * takes the upper 16 bits, so the pool memory must be below 2^48.
+ */
+
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+#  if UINTPTR_MAX <= UINT32_MAX
+#    define MEMPOOL_TAG_SHIFT 32
+#  else
+#    define MEMPOOL_TAG_SHIFT 48
+#  endif
+
+#  define MEMPOOL_PTR_MASK ((UINT64_C(1) << MEMPOOL_TAG_SHIFT) - 1)
+#  define MEMPOOL_TAG_PTR(t) \
+     ((FAR sq_entry_t *)(uintptr_t)((uint64_t)(t) & MEMPOOL_PTR_MASK))
+#  define MEMPOOL_TAG_NEXT(t, p) \
+     ((int64_t)((((uint64_t)(t) + (UINT64_C(1) << MEMPOOL_TAG_SHIFT)) & \
+                 ~MEMPOOL_PTR_MASK) | (uintptr_t)(p)))
+
+/* The free stack is updated without the pool lock */
+
+#  define mempool_queue_lock(pool)       0
+#  define mempool_queue_unlock(pool, f)  UNUSED(f)
+#else
+#  define mempool_queue_lock(pool)       spin_lock_irqsave(&(pool)->lock)
+#  define mempool_queue_unlock(pool, f) \
+     spin_unlock_irqrestore(&(pool)->lock, f)
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0x55555555
 #define MEMPOOL_MAGIC_ALLOC 0xAAAAAAAA
@@ -100,6 +139,338 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+
+/****************************************************************************
+ * Name: mempool_lockfree_pop
+ *
+ * Description:
+ *   Pop a block from the lock-free free block stack.  Reading the link of
+ *   a block that was just taken by another CPU is harmless, because the
+ *   pool memory is never returned before mempool_deinit() and the tag
+ *   makes the following compare-and-swap fail.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_lockfree_pop(FAR struct mempool_s *pool)
+{
+  FAR sq_entry_t *blk;
+  FAR sq_entry_t *next;
+  int64_t head;
+
+  head = atomic64_read_acquire(&pool->lfhead);
+  do
+    {
+      blk = MEMPOOL_TAG_PTR(head);
+      if (blk == NULL)
+        {
+          return NULL;
+        }
+
+      next = blk->flink;
+    }
+  while (!atomic64_try_cmpxchg(&pool->lfhead, &head,
+                               MEMPOOL_TAG_NEXT(head, next)));
+
+  if (next != NULL)
+    {
+      pool->check(pool, next);
+    }
+
+  blk->flink = NULL;
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_lockfree_push
+ *
+ * Description:
+ *   Push a chain of blocks linked from first to last onto the lock-free
+ *   free block stack with a single compare-and-swap.
+ *
+ ****************************************************************************/
+
+static void mempool_lockfree_push(FAR struct mempool_s *pool,
+                                  FAR sq_entry_t *first,
+                                  FAR sq_entry_t *last)
+{
+  int64_t head = atomic64_read(&pool->lfhead);
+
+  DEBUGASSERT(((uintptr_t)first & ~MEMPOOL_PTR_MASK) == 0);
+  do
+    {
+      last->flink = MEMPOOL_TAG_PTR(head);
+    }
+  while (!atomic64_try_cmpxchg(&pool->lfhead, &head,
+                               MEMPOOL_TAG_NEXT(head, first)));
+}
+
+/****************************************************************************
+ * Name: mempool_lockfree_count
+ *
+ * Description:
+ *   Get the number of blocks on the lock-free free block stack.  The stack
+ *   can't be walked safely while other CPUs pop, so derive the count from
+ *   the blocks handed out of the normal pool.
+ *
+ ****************************************************************************/
+
+static size_t mempool_lockfree_count(FAR struct mempool_s *pool)
+{
+  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  size_t nused = atomic_read(&pool->nalloc);
+  size_t niused = 0;
+
+  if (pool->ibase != NULL)
+    {
+      niused = pool->interruptsize / blocksize - sq_count(&pool->iqueue);
+    }
+
+  nused -= MIN(nused, niused);
+  return pool->nblocks > nused ? pool->nblocks - nused : 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: mempool_get_free
+ *
+ * Description:
+ *   Take a block from the normal free blocks, the caller must hold the
+ *   queue lock.
+ *
+ ****************************************************************************/
+
+static inline FAR sq_entry_t *mempool_get_free(FAR struct mempool_s *pool)
+{
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  return mempool_lockfree_pop(pool);
+#else
+  return mempool_remove_queue(pool, &pool->queue);
+#endif
+}
+
+/****************************************************************************
+ * Name: mempool_put_free
+ *
+ * Description:
+ *   Return a block to the normal free blocks, the caller must hold the
+ *   queue lock.
+ *
+ ****************************************************************************/
+
+static inline void mempool_put_free(FAR struct mempool_s *pool,
+                                    FAR sq_entry_t *blk)
+{
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  mempool_lockfree_push(pool, blk, blk);
+#else
+  sq_addlast(blk, &pool->queue);
+#endif
+}
+
+/****************************************************************************
+ * Name: mempool_put_blocks
+ *
+ * Description:
+ *   Add nblks new blocks starting at base to the normal free blocks, the
+ *   caller must hold the queue lock.
+ *
+ ****************************************************************************/
+
+static void mempool_put_blocks(FAR struct mempool_s *pool, FAR char *base,
+                               size_t nblks, size_t blocksize)
+{
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  FAR sq_entry_t *first = NULL;
+  FAR sq_entry_t *last = NULL;
+  FAR sq_entry_t *blk;
+
+  pool->nblocks += nblks;
+  while (nblks-- > 0)
+    {
+#  if CONFIG_MM_BACKTRACE >= 0
+      FAR struct mempool_backtrace_s *buf =
+       (FAR struct mempool_backtrace_s *)
+       (base + nblks * blocksize + pool->blocksize);
+
+      buf->magic = MEMPOOL_MAGIC_FREE;
+#  endif
+      blk = (FAR sq_entry_t *)(base + blocksize * nblks);
+      blk->flink = first;
+      first = blk;
+      if (last == NULL)
+        {
+          last = blk;
+        }
+    }
+
+  if (first != NULL)
+    {
+      mempool_lockfree_push(pool, first, last);
+    }
+#else
+  mempool_add_queue(pool, &pool->queue, base, nblks, blocksize);
+#endif
+}
+
+/****************************************************************************
+ * Name: mempool_count_free
+ *
+ * Description:
+ *   Get the number of the normal free blocks.
+ *
+ ****************************************************************************/
+
+static inline size_t mempool_count_free(FAR struct mempool_s *pool)
+{
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  return mempool_lockfree_count(pool);
+#else
+  return sq_count(&pool->queue);
+#endif
+}
+
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+
+/****************************************************************************
+ * Name: mempool_percpu_alloc
+ *
+ * Description:
+ *   Take a free block from the cache of the current CPU.  Only interrupts
+ *   of this CPU are disabled, the queue lock is taken once per batch to
+ *   refill an empty cache from the shared free blocks.
+ *
+ *   The blocks held by the caches are counted in nalloc, since they have
+ *   left the shared free blocks.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_percpu_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_percpu_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->count == 0)
+    {
+      irqstate_t qflags = mempool_queue_lock(pool);
+
+      while (cache->count < MEMPOOL_PERCPU_BATCH &&
+             (blk = mempool_get_free(pool)) != NULL)
+        {
+          blk->flink = cache->head;
+          cache->head = blk;
+          cache->count++;
+        }
+
+      mempool_queue_unlock(pool, qflags);
+      atomic_fetch_add(&pool->nalloc, cache->count);
+    }
+
+  blk = cache->head;
+  if (blk != NULL)
+    {
+      cache->head = blk->flink;
+      cache->count--;
+      blk->flink = NULL;
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_release
+ *
+ * Description:
+ *   Put a free block into the cache of the current CPU, return a batch of
+ *   blocks to the shared free blocks once the cache is full.
+ *
+ ****************************************************************************/
+
+static void mempool_percpu_release(FAR struct mempool_s *pool,
+                                   FAR sq_entry_t *blk)
+{
+  FAR struct mempool_percpu_s *cache;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  blk->flink = cache->head;
+  cache->head = blk;
+  if (++cache->count >= CONFIG_MM_MEMPOOL_PERCPU_CACHE)
+    {
+      irqstate_t qflags = mempool_queue_lock(pool);
+
+      while (cache->count >
+             CONFIG_MM_MEMPOOL_PERCPU_CACHE - MEMPOOL_PERCPU_BATCH)
+        {
+          blk = cache->head;
+          cache->head = blk->flink;
+          cache->count--;
+          mempool_put_free(pool, blk);
+        }
+
+      mempool_queue_unlock(pool, qflags);
+      atomic_fetch_sub(&pool->nalloc, MEMPOOL_PERCPU_BATCH);
+    }
+
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_flush
+ *
+ * Description:
+ *   Return the cached blocks of all CPUs to the shared free blocks.  The
+ *   caller must hold the queue lock.
+ *
+ ****************************************************************************/
+
+static void mempool_percpu_flush(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_percpu_s *cache;
+  FAR sq_entry_t *blk;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &pool->cache[cpu];
+      while ((blk = cache->head) != NULL)
+        {
+          cache->head = blk->flink;
+          mempool_put_free(pool, blk);
+        }
+
+      atomic_fetch_sub(&pool->nalloc, cache->count);
+      cache->count = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_count
+ *
+ * Description:
+ *   Get the number of blocks cached by all CPUs.
+ *
+ ****************************************************************************/
+
+static size_t mempool_percpu_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->cache[cpu].count;
+    }
+
+  return count;
+}
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -261,7 +632,12 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->queue);
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
-  pool->nalloc = 0;
+  atomic_set(&pool->nalloc, 0);
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  atomic64_set(&pool->lfhead, 0);
+  pool->nblocks = 0;
+#endif
+
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -300,8 +676,7 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
           return -ENOMEM;
         }
 
-      mempool_add_queue(pool, &pool->queue,
-                        base, ninitial, blocksize);
+      mempool_put_blocks(pool, base, ninitial, blocksize);
       sq_addlast((FAR sq_entry_t *)(base + ninitial * blocksize),
                   &pool->equeue);
       kasan_poison(base, size);
@@ -313,6 +688,19 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
       nxsem_init(&pool->waitsem, 0, 0);
     }
 
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  /* The interrupt blocks must go back to their own queue and the waiters
+   * must see every released block, so these pools can't be cached.
+   */
+
+  if (pool->interruptsize > 0 || (pool->wait && pool->expandsize == 0))
+    {
+      pool->percpu = false;
+    }
+
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   mempool_procfs_register(&pool->procfs, name);
 #  ifdef CONFIG_MM_BACKTRACE_DEFAULT
@@ -347,9 +735,32 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  if (pool->percpu)
+    {
+      blk = mempool_percpu_alloc(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+  /* The lock is only needed to take the interrupt blocks, expand the pool
+   * or wait for a free block.
+   */
+
+  blk = mempool_lockfree_pop(pool);
+  if (blk != NULL)
+    {
+      goto alloced;
+    }
+#endif
+
   flags = spin_lock_irqsave(&pool->lock);
-  blk = mempool_remove_queue(pool, &pool->queue);
+  blk = mempool_get_free(pool);
   if (blk == NULL)
     {
       if (up_interrupt_context())
@@ -380,11 +791,17 @@ retry:
 
               kasan_poison(base, size);
               flags = spin_lock_irqsave(&pool->lock);
-              mempool_add_queue(pool, &pool->queue,
-                                base, nexpand, blocksize);
+              mempool_put_blocks(pool, base, nexpand, blocksize);
               sq_addlast((FAR sq_entry_t *)(base + nexpand * blocksize),
                          &pool->equeue);
-              blk = mempool_remove_queue(pool, &pool->queue);
+              blk = mempool_get_free(pool);
+              if (blk == NULL)
+                {
+                  /* The lock-free pops of other CPUs took all new blocks */
+
+                  spin_unlock_irqrestore(&pool->lock, flags);
+                  goto retry;
+                }
             }
           else if (!pool->wait ||
                    nxsem_wait_uninterruptible(&pool->waitsem) < 0)
@@ -398,9 +815,16 @@ retry:
         }
     }
 
-  pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
 
+#ifdef CONFIG_MM_MEMPOOL_LOCKFREE
+alloced:
+#endif
+  atomic_fetch_add(&pool->nalloc, 1);
+
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+out:
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -427,8 +851,8 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -440,31 +864,37 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 
 #endif
 
-  pool->nalloc--;
-
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   memset(blk, MM_FREE_MAGIC, pool->blocksize);
 #endif
 
-  if (pool->interruptsize > blocksize)
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  if (pool->percpu)
     {
-      if ((FAR char *)blk >= pool->ibase &&
-          (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize)
-        {
-          sq_addlast(blk, &pool->iqueue);
-        }
-      else
-        {
-          sq_addlast(blk, &pool->queue);
-        }
+      kasan_poison(blk, pool->blocksize);
+      mempool_percpu_release(pool, blk);
+      return;
+    }
+#endif
+
+  atomic_fetch_sub(&pool->nalloc, 1);
+  kasan_poison(blk, pool->blocksize);
+
+  if (pool->interruptsize > blocksize &&
+      (FAR char *)blk >= pool->ibase &&
+      (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize)
+    {
+      flags = spin_lock_irqsave(&pool->lock);
+      sq_addlast(blk, &pool->iqueue);
+      spin_unlock_irqrestore(&pool->lock, flags);
     }
   else
     {
-      sq_addlast(blk, &pool->queue);
+      flags = mempool_queue_lock(pool);
+      mempool_put_free(pool, blk);
+      mempool_queue_unlock(pool, flags);
     }
 
-  kasan_poison(blk, pool->blocksize);
-  spin_unlock_irqrestore(&pool->lock, flags);
   if (pool->wait && pool->expandsize == 0)
     {
       int semcount;
@@ -499,11 +929,18 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   DEBUGASSERT(pool != NULL && info != NULL);
 
   flags = spin_lock_irqsave(&pool->lock);
-  info->ordblks = sq_count(&pool->queue);
   info->iordblks = sq_count(&pool->iqueue);
-  info->aordblks = pool->nalloc;
+  info->ordblks = mempool_count_free(pool);
+  info->aordblks = atomic_read(&pool->nalloc);
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  info->ncached = mempool_percpu_count(pool);
+  info->aordblks -= info->ncached;
+#else
+  info->ncached = 0;
+#endif
   info->arena = sq_count(&pool->equeue) * MEMPOOL_HEADER_SIZE +
-    (info->aordblks + info->ordblks + info->iordblks) * blocksize;
+    (info->aordblks + info->ordblks + info->iordblks + info->ncached) *
+    blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
   info->sizeblks = blocksize;
   if (pool->wait && pool->expandsize == 0)
@@ -538,17 +975,26 @@ mempool_info_task(FAR struct mempool_s *pool,
   if (task->pid == PID_MM_FREE)
     {
       irqstate_t flags = spin_lock_irqsave(&pool->lock);
-      size_t count = sq_count(&pool->queue) +
+      size_t count = mempool_count_free(pool) +
                      sq_count(&pool->iqueue);
 
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+      count += mempool_percpu_count(pool);
+#endif
+
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = atomic_read(&pool->nalloc);
+
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+      count -= mempool_percpu_count(pool);
+#endif
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -618,7 +1064,17 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
-  if (pool->nalloc != 0)
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+  if (pool->percpu)
+    {
+      irqstate_t flags = mempool_queue_lock(pool);
+
+      mempool_percpu_flush(pool);
+      mempool_queue_unlock(pool, flags);
+    }
+#endif
+
+  if (atomic_read(&pool->nalloc) != 0)
     {
       return -EBUSY;
     }
@@ -463,6 +463,9 @@ mempool_multiple_init(FAR const char *name,
       pools[i].alloc = mempool_multiple_alloc_callback;
       pools[i].free = mempool_multiple_free_callback;
       pools[i].check = mempool_multiple_check;
+#if CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+      pools[i].percpu = true;
+#endif
 
       ret = mempool_init(pools + i, name);
       if (ret < 0)
@@ -775,9 +778,10 @@ mempool_multiple_mallinfo(FAR struct mempool_multiple_s *mpool)
       struct mempoolinfo_s poolinfo;
 
       mempool_info(mpool->pools + i, &poolinfo);
-      info.fordblks += (poolinfo.ordblks + poolinfo.iordblks)
-                       * poolinfo.sizeblks;
-      info.ordblks += poolinfo.ordblks + poolinfo.iordblks;
+      info.fordblks += (poolinfo.ordblks + poolinfo.iordblks +
+                        poolinfo.ncached) * poolinfo.sizeblks;
+      info.ordblks += poolinfo.ordblks + poolinfo.iordblks +
+                      poolinfo.ncached;
       info.aordblks += poolinfo.aordblks;
       if (info.mxordblk < poolinfo.sizeblks)
         {
@@ -44,8 +44,11 @@
 
 #define SIZEOF_GAT(n) \
   ((n + 31) >> 5)
+#define SIZEOF_GSUM(n) \
+  SIZEOF_GAT(SIZEOF_GAT(n))
 #define SIZEOF_GRAN_S(n) \
-  (sizeof(struct gran_s) + sizeof(uint32_t) * (SIZEOF_GAT(n) - 1))
+  (sizeof(struct gran_s) + \
+   sizeof(uint32_t) * (SIZEOF_GAT(n) + SIZEOF_GSUM(n) - 1))
 
 /* Debug */
 
@@ -77,6 +80,7 @@ struct gran_s
   mutex_t    lock;       /* For exclusive access to the GAT */
 #endif
   uintptr_t  heapstart; /* The aligned start of the granule heap */
+  FAR uint32_t *gsum;   /* Summary, one bit per GAT cell with free bits */
   uint32_t   gat[1];    /* Start of the granule allocation table */
 };
 
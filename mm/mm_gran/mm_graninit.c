@@ -102,6 +102,7 @@ GRAN_HANDLE gran_initialize(FAR void *heapstart, size_t heapsize,
   unsigned int       mask;
   unsigned int       alignedsize;
   unsigned int       ngranules;
+  unsigned int       cell;
 
   /* Check parameters if debug is on.  Note the size of a granule is
    * limited to 2**31 bytes and that the size of the granule must be greater
@@ -138,6 +139,14 @@ GRAN_HANDLE gran_initialize(FAR void *heapstart, size_t heapsize,
       priv->ngranules = ngranules;
       priv->heapstart = alignedstart;
 
+      /* The summary follows the GAT, initially every cell has free bits */
+
+      priv->gsum      = &priv->gat[SIZEOF_GAT(ngranules)];
+      for (cell = 0; cell < SIZEOF_GAT(ngranules); cell++)
+        {
+          priv->gsum[cell >> 5] |= 1u << (cell & 31);
+        }
+
       /* Initialize mutual exclusion support */
 
 #ifndef CONFIG_GRAN_INTR
@@ -90,6 +90,28 @@ uint32_t lsb_mask(uint32_t n)
   return (-n & n) & GATCFULL;
 }
 
+/* return the index of the least significant set bit, n is not zero */
+
+static inline unsigned int gat_ctz(uint32_t n)
+{
+#ifdef CONFIG_HAVE_BUILTIN_CTZ
+  return __builtin_ctz(n);
+#else
+  return DEBRUJIN_LUT[(uint32_t)(lsb_mask(n) * DEBRUJIN_NUM) >> 27];
+#endif
+}
+
+/* return the number of leading zero bits, n is not zero */
+
+static inline unsigned int gat_clz(uint32_t n)
+{
+#ifdef CONFIG_HAVE_BUILTIN_CLZ
+  return __builtin_clz(n);
+#else
+  return 31 - DEBRUJIN_LUT[(uint32_t)(msb_mask(n) * DEBRUJIN_NUM) >> 27];
+#endif
+}
+
 /* set or clear a GAT cell with given bit mask */
 
 static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
@@ -102,6 +124,38 @@ static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
     {
       gran->gat[cell] &= ~mask;
     }
+
+  /* keep the summary bit of the cell in sync */
+
+  if (gran->gat[cell] == GATCFULL)
+    {
+      gran->gsum[cell >> 5] &= ~(1u << (cell & 31));
+    }
+  else
+    {
+      gran->gsum[cell >> 5] |= 1u << (cell & 31);
+    }
+}
+
+/* return the offset of the first run of size (< 32) free bits inside a
+ * GAT cell or negative if there is none.  Bit p of m is kept set while
+ * granules p .. p + len - 1 are all free, len doubles on each round.
+ */
+
+static int cell_search(uint32_t v, size_t size)
+{
+  uint32_t m = ~v;
+  size_t len = 1;
+  size_t sh;
+
+  while (len < size && m != 0)
+    {
+      sh   = len < size - len ? len : size - len;
+      m   &= m >> sh;
+      len += sh;
+    }
+
+  return m != 0 ? (int)gat_ctz(m) : -1;
 }
 
 /* set or clear a range of GAT bits */
@@ -255,28 +309,95 @@ failure:
   return false;
 }
 
-/* returns granule number of free range or negative error */
+/* returns granule number of free range or negative error.  The first fit
+ * is found with the summary bitmap to skip full cells 32 at a time and
+ * clz/ctz on the others, a free run spanning cells is tracked through the
+ * free tail of one cell, the empty cells and the free head of the last.
+ */
 
 int gran_search(const gran_t *gran, size_t size)
 {
-  int ret = -EINVAL;
+  size_t ncells;
+  size_t start = 0;  /* first granule of the free run reaching cell c */
+  size_t run = 0;    /* length of that run */
+  size_t c = 0;
+  uint32_t s;
+  uint32_t v;
+  int posi;
 
   if (gran == NULL || gran->ngranules < size)
     {
-      return ret;
+      return -EINVAL;
     }
 
-  ret = -ENOMEM;
-  for (size_t i = 0; i <= gran->ngranules - size; i++)
+  ncells = SIZEOF_GAT(gran->ngranules);
+  while (c < ncells)
     {
-      if (gran_match(gran, i, size, 0, &i))
+      /* skip the full cells with the summary */
+
+      s = gran->gsum[c >> 5] & (GATCFULL << (c & 31));
+      if (s == 0)
+        {
+          run = 0;
+          c   = (c | 31) + 1;
+          continue;
+        }
+
+      if ((c & 31) != gat_ctz(s))
+        {
+          run = 0;
+          c   = (c & ~31) | gat_ctz(s);
+        }
+
+      /* granules beyond the end of the heap count as used */
+
+      v = gran->gat[c];
+      if (c == ncells - 1 && (gran->ngranules & 31) != 0)
+        {
+          v |= GATCFULL << (gran->ngranules & 31);
+        }
+
+      if (run == 0)
         {
-          ret = i;
-          break;
+          start = c << 5;
         }
+
+      if (v == 0)
+        {
+          run += 32;
+          if (run >= size)
+            {
+              return start;
+            }
+
+          c++;
+          continue;
+        }
+
+      /* the run reaching this cell ends at its first used granule */
+
+      if (run + gat_ctz(v) >= size)
+        {
+          return start;
+        }
+
+      if (size < 32)
+        {
+          posi = cell_search(v, size);
+          if (posi >= 0)
+            {
+              return (c << 5) + posi;
+            }
+        }
+
+      /* a new run may start with the free tail of this cell */
+
+      run   = gat_clz(v);
+      start = (c << 5) + 32 - run;
+      c++;
     }
 
-  return ret;
+  return -ENOMEM;
 }
 
 /* set a range of granules */
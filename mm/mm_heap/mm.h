@@ -29,6 +29,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/atomic.h>
 #include <nuttx/mutex.h>
 #include <nuttx/sched.h>
 #include <nuttx/fs/procfs.h>
@@ -40,6 +42,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 
 /****************************************************************************
@@ -115,6 +118,16 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* With the segregated fit every power of two size class (the first level)
+ * is split into MM_SL_COUNT linear ranges (the second level), each with
+ * its own free list.
+ */
+
+#ifdef CONFIG_MM_HEAP_SEGREGATED_FIT
+#  define MM_SL_SHIFT    3
+#  define MM_SL_COUNT    (1 << MM_SL_SHIFT)
+#endif
+
 #define MM_GRAN_MASK     (MM_ALIGN - 1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -158,6 +171,37 @@
 #define MM_PREVNODE_IS_ALLOC(node) (((node)->size & MM_PREVFREE_BIT) == 0)
 #define MM_PREVNODE_IS_FREE(node) (((node)->size & MM_PREVFREE_BIT) != 0)
 
+/* Check the links of a free node with its neighbors in the free list */
+
+#ifdef CONFIG_MM_HEAP_SEGREGATED_FIT
+#  define MM_FREENODE_IS_VALID(node) \
+     (((node)->blink == NULL || (node)->blink->flink == (node)) && \
+      ((node)->flink == NULL || (node)->flink->blink == (node)))
+#else
+#  define MM_FREENODE_IS_VALID(node) \
+     ((node)->blink->flink == (node) && \
+      MM_SIZEOF_NODE((node)->blink) <= MM_SIZEOF_NODE(node) && \
+      ((node)->flink == NULL || (node)->flink->blink == (node)) && \
+      ((node)->flink == NULL || MM_SIZEOF_NODE((node)->flink) == 0 || \
+       MM_SIZEOF_NODE((node)->flink) >= MM_SIZEOF_NODE(node)))
+#endif
+
+/* Heap statistics, the latency is sampled with the perf counter and kept
+ * in per-CPU histograms.
+ */
+
+#ifdef CONFIG_MM_HEAP_STATISTICS
+#  define MM_STAT_START(start)       clock_t start = up_perf_gettime()
+#  define MM_STAT_MALLOC(heap, start) \
+     mm_stat_latency((heap)->mm_stat[this_cpu()].mallocs, start)
+#  define MM_STAT_FREE(heap, start) \
+     mm_stat_latency((heap)->mm_stat[this_cpu()].frees, start)
+#else
+#  define MM_STAT_START(start)
+#  define MM_STAT_MALLOC(heap, start)
+#  define MM_STAT_FREE(heap, start)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -214,6 +258,16 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+/* Latency histograms updated by one CPU, summed up by mm_heapstat() */
+
+struct mm_heapstat_percpu_s
+{
+  atomic_t mallocs[MM_STAT_NBUCKETS];
+  atomic_t frees[MM_STAT_NBUCKETS];
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -243,12 +297,23 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_HEAP_SEGREGATED_FIT
+  /* Free nodes are kept in unsorted doubly linked lists indexed by the
+   * size class and the linear range inside the class.  The bitmaps mark
+   * the non-empty lists, so a fitting list is found with two bit scans.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_NNODES];
+  FAR struct mm_freenode_s *mm_freelist[MM_NNODES][MM_SL_COUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed up searching of free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
 
   /* Free delay list, as sometimes we can't do free immdiately. */
 
@@ -258,6 +323,13 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+  /* Allocation latency and the lowest largest free chunk seen so far */
+
+  struct mm_heapstat_percpu_s mm_stat[CONFIG_SMP_NCPUS];
+  size_t mm_minlargest;
+#endif
+
   /* The is a multiple mempool of the heap */
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
@@ -304,6 +376,21 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
  * Inline Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+static inline_function int mm_stat_bucket(size_t value)
+{
+  int ndx = flsl(value);
+
+  return ndx < MM_STAT_NBUCKETS ? ndx : MM_STAT_NBUCKETS - 1;
+}
+
+static inline_function void mm_stat_latency(FAR atomic_t *hist,
+                                            clock_t start)
+{
+  atomic_fetch_add(&hist[mm_stat_bucket(up_perf_gettime() - start)], 1);
+}
+#endif
+
 static inline_function int mm_size2ndx(size_t size)
 {
   DEBUGASSERT(size >= MM_MIN_CHUNK);
@@ -316,6 +403,145 @@ static inline_function int mm_size2ndx(size_t size)
   return flsl(size) - 1;
 }
 
+#ifdef CONFIG_MM_HEAP_SEGREGATED_FIT
+static inline_function void mm_size2list(size_t size, FAR int *fl,
+                                         FAR int *sl)
+{
+  size_t idx;
+
+  *fl = mm_size2ndx(size);
+  idx = size >> (*fl + MM_MIN_SHIFT - MM_SL_SHIFT);
+
+  /* The last class also holds all the chunks beyond MM_MAX_CHUNK */
+
+  *sl = idx >= 2 * MM_SL_COUNT ? MM_SL_COUNT - 1 : idx - MM_SL_COUNT;
+}
+
+static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *next;
+  size_t nodesize = MM_SIZEOF_NODE(node);
+  int fl;
+  int sl;
+
+  DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
+  DEBUGASSERT(MM_NODE_IS_FREE(node));
+
+  /* Push the node at the head of its list and mark the list non-empty */
+
+  mm_size2list(nodesize, &fl, &sl);
+  next = heap->mm_freelist[fl][sl];
+
+  node->blink = NULL;
+  node->flink = next;
+  if (next)
+    {
+      next->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_slbitmap[fl] |= 1 << sl;
+  heap->mm_flbitmap |= 1 << fl;
+}
+
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      /* The node is the head of its list, clear the bitmaps once the list
+       * is empty.
+       */
+
+      mm_size2list(MM_SIZEOF_NODE(node), &fl, &sl);
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+
+      heap->mm_freelist[fl][sl] = node->flink;
+      if (node->flink == NULL)
+        {
+          heap->mm_slbitmap[fl] &= ~(1 << sl);
+          if (heap->mm_slbitmap[fl] == 0)
+            {
+              heap->mm_flbitmap &= ~(1 << fl);
+            }
+        }
+    }
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+}
+
+static inline_function FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  uint32_t bitmap;
+  size_t round;
+  int fl;
+  int sl;
+
+  /* Round the size up to the start of the next list, so the head of any
+   * non-empty list at or above it is large enough.
+   */
+
+  mm_size2list(size, &fl, &sl);
+  round = size + (1 << (fl + MM_MIN_SHIFT - MM_SL_SHIFT)) - 1;
+  if (round > size)
+    {
+      mm_size2list(round, &fl, &sl);
+    }
+
+  bitmap = heap->mm_slbitmap[fl] & (UINT32_MAX << sl);
+  if (bitmap == 0 && fl < MM_NNODES - 1)
+    {
+      bitmap = heap->mm_flbitmap & (UINT32_MAX << (fl + 1));
+      if (bitmap != 0)
+        {
+          fl = ffs(bitmap) - 1;
+          bitmap = heap->mm_slbitmap[fl];
+        }
+    }
+
+  if (bitmap != 0)
+    {
+      /* Only the last list of the last class mixes the sizes */
+
+      sl = ffs(bitmap) - 1;
+      for (node = heap->mm_freelist[fl][sl]; node; node = node->flink)
+        {
+          if (MM_SIZEOF_NODE(node) >= size)
+            {
+              return node;
+            }
+        }
+    }
+
+  /* Fall back to the nodes in the list of the size itself, they may still
+   * be large enough.
+   */
+
+  mm_size2list(size, &fl, &sl);
+  for (node = heap->mm_freelist[fl][sl]; node; node = node->flink)
+    {
+      if (MM_SIZEOF_NODE(node) >= size)
+        {
+          break;
+        }
+    }
+
+  return node;
+}
+#else
 static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
                                             FAR struct mm_freenode_s *node)
 {
@@ -352,4 +578,41 @@ static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
     }
 }
 
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  /* There must be a predecessor, but there may not be a successor node */
+
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+}
+
+static inline_function FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[mm_size2ndx(size)].flink; node;
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+      if (MM_SIZEOF_NODE(node) >= size)
+        {
+          break;
+        }
+    }
+
+  return node;
+}
+#endif
+
 #endif /* __MM_MM_HEAP_MM_H */
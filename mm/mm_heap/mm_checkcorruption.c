@@ -53,13 +53,7 @@ static void checkcorruption_handler(FAR struct mm_allocnode_s *node,
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       ASSERT(nodesize >= MM_MIN_CHUNK);
-      ASSERT(fnode->blink->flink == fnode);
-      ASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      ASSERT(fnode->flink == NULL ||
-             fnode->flink->blink == fnode);
-      ASSERT(fnode->flink == NULL ||
-             MM_SIZEOF_NODE(fnode->flink) == 0 ||
-             MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+      ASSERT(MM_FREENODE_IS_VALID(fnode));
     }
 }
 
@@ -235,7 +235,9 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 {
   FAR struct mm_heap_s *heap;
   uintptr_t             heap_adj;
+#ifndef CONFIG_MM_HEAP_SEGREGATED_FIT
   int                   i;
+#endif
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
 
@@ -256,14 +258,21 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
   /* Set up global variables */
 
   memset(heap, 0, sizeof(struct mm_heap_s));
+#ifdef CONFIG_MM_HEAP_STATISTICS
+  heap->mm_minlargest = SIZE_MAX;
+#endif
 
-  /* Initialize the node array */
+  /* Initialize the node array, the segregated fit index starts out empty
+   * and has already been cleared above.
+   */
 
+#ifndef CONFIG_MM_HEAP_SEGREGATED_FIT
   for (i = 1; i < MM_NNODES; i++)
     {
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc mutex to one (to support one-at-
    * a-time access to private data sets).
@@ -26,6 +26,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
+
 #include <assert.h>
 #include <debug.h>
 
@@ -69,13 +71,7 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+      DEBUGASSERT(MM_FREENODE_IS_VALID(fnode));
 
       info->ordblks++;
       info->fordblks += nodesize;
@@ -113,6 +109,47 @@ static void mallinfo_task_handler(FAR struct mm_allocnode_s *node,
     }
 }
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+static void heapstat_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct mm_heapstat_s *stat = arg;
+  size_t nodesize = MM_SIZEOF_NODE(node);
+
+  if (MM_NODE_IS_FREE(node))
+    {
+      stat->freehist[mm_stat_bucket(nodesize)]++;
+      if (nodesize > stat->largest)
+        {
+          stat->largest = nodesize;
+        }
+    }
+}
+
+static size_t heapstat_largest(FAR struct mm_heap_s *heap, size_t largest)
+{
+  size_t minlargest;
+
+  /* Record the sample and return the lowest largest free chunk seen.  The
+   * sample is dropped if the heap can't be locked here.
+   */
+
+  if (mm_lock(heap) < 0)
+    {
+      minlargest = heap->mm_minlargest;
+      return largest < minlargest ? largest : minlargest;
+    }
+
+  if (largest < heap->mm_minlargest)
+    {
+      heap->mm_minlargest = largest;
+    }
+
+  minlargest = heap->mm_minlargest;
+  mm_unlock(heap);
+  return minlargest;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -148,6 +185,10 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
 
   DEBUGASSERT(info.uordblks + info.fordblks == info.arena);
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+  heapstat_largest(heap, info.mxordblk);
+#endif
+
   return info;
 }
 
@@ -204,6 +245,27 @@ size_t mm_heapfree(FAR struct mm_heap_s *heap)
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 {
   FAR struct mm_freenode_s *node;
+#ifdef CONFIG_MM_HEAP_SEGREGATED_FIT
+  size_t largest = 0;
+  int fl;
+  int sl;
+
+  /* The largest chunk lives in the highest non-empty list */
+
+  if (heap->mm_flbitmap == 0)
+    {
+      return 0;
+    }
+
+  fl = fls(heap->mm_flbitmap) - 1;
+  sl = fls(heap->mm_slbitmap[fl]) - 1;
+  for (node = heap->mm_freelist[fl][sl]; node; node = node->flink)
+    {
+      largest = MAX(largest, MM_SIZEOF_NODE(node));
+    }
+
+  return largest;
+#else
   for (node = heap->mm_nodelist[MM_NNODES - 1].blink; node;
        node = node->blink)
     {
@@ -215,4 +277,37 @@ size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
     }
 
   return 0;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_heapstat
+ *
+ * Description:
+ *   Return the histogram of the free chunks by size, the largest free chunk
+ *   trend and the mm_malloc()/mm_free() latency histograms of the heap.
+ *   The latency is counted in perf counter cycles.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_STATISTICS
+void mm_heapstat(FAR struct mm_heap_s *heap,
+                 FAR struct mm_heapstat_s *stat)
+{
+  int cpu;
+  int i;
+
+  memset(stat, 0, sizeof(*stat));
+  mm_foreach(heap, heapstat_handler, stat);
+  stat->minlargest = heapstat_largest(heap, stat->largest);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      for (i = 0; i < MM_STAT_NBUCKETS; i++)
+        {
+          stat->mallocs[i] += atomic_read(&heap->mm_stat[cpu].mallocs[i]);
+          stat->frees[i] += atomic_read(&heap->mm_stat[cpu].frees[i]);
+        }
+    }
 }
+#endif
@@ -130,9 +130,9 @@ void mm_mempool_dump_handle(FAR struct mempool_s *pool, FAR void *arg)
   struct mempoolinfo_s info;
 
   mempool_info(pool, &info);
-  mwarn("%9lu%11lu%9lu%9lu%9lu%9lu\n",
+  mwarn("%9lu%11lu%9lu%9lu%9lu%9lu%9lu\n",
         info.sizeblks, info.arena, info.aordblks,
-        info.ordblks, info.iordblks, info.nwaiter);
+        info.ordblks, info.iordblks, info.nwaiter, info.ncached);
 }
 #endif
 
@@ -173,7 +173,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   size_t alignsize;
   size_t nodesize;
   FAR void *ret = NULL;
-  int ndx;
+  MM_STAT_START(start);
 
   /* Free the delay list first */
 
@@ -185,6 +185,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = mempool_multiple_alloc(heap->mm_mpool, size);
       if (ret != NULL)
         {
+          MM_STAT_MALLOC(heap, start);
           return ret;
         }
     }
@@ -214,29 +215,11 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   DEBUGVERIFY(mm_lock(heap));
 
-  /* Convert the request size into a nodelist index */
+  /* Search for the free chunk that fits the request */
 
-  ndx = mm_size2ndx(alignsize);
+  node = mm_findfreechunk(heap, alignsize);
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-      nodesize = MM_SIZEOF_NODE(node);
-      if (nodesize >= alignsize)
-        {
-          break;
-        }
-    }
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
-   */
+  /* If we found a node with non-zero size, then this is one to use. */
 
   if (node)
     {
@@ -244,16 +227,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      nodesize = MM_SIZEOF_NODE(node);
+      mm_delfreechunk(heap, node);
 
       /* Get a pointer to the next node in physical memory */
 
@@ -329,6 +306,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 
   mm_unlock(heap);
+  MM_STAT_MALLOC(heap, start);
 
   if (ret)
     {
@@ -379,9 +357,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       mm_dump_handler(NULL, heap);
 #  endif
 #  ifdef CONFIG_MM_HEAP_MEMPOOL
-      mwarn("%11s%9s%9s%9s%9s%9s\n",
+      mwarn("%11s%9s%9s%9s%9s%9s%9s\n",
             "bsize", "total", "nused",
-            "nfree", "nifree", "nwaiter");
+            "nfree", "nifree", "nwaiter", "ncached");
       mempool_multiple_foreach(heap->mm_mpool,
                                mm_mempool_dump_handle, NULL);
 #  endif
@@ -51,6 +51,9 @@ struct mm_memdump_priv_s
   FAR struct mm_allocnode_s *node[CONFIG_MM_HEAP_BIGGEST_COUNT];
   size_t filled;
 #endif
+#ifdef CONFIG_MM_HEAP_STATISTICS
+  unsigned long freehist[MM_STAT_NBUCKETS];
+#endif
 };
 
 /****************************************************************************
@@ -193,16 +196,13 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+      DEBUGASSERT(MM_FREENODE_IS_VALID(fnode));
 
       priv->info.aordblks++;
       priv->info.uordblks += nodesize;
+#ifdef CONFIG_MM_HEAP_STATISTICS
+      priv->freehist[mm_stat_bucket(nodesize)]++;
+#endif
       syslog(LOG_INFO, "%12zu%9zu%*p\n",
              nodesize, MM_ALLOCNODE_OVERHEAD, BACKTRACE_PTR_FMT_WIDTH,
              ((FAR char *)node + MM_SIZEOF_ALLOCNODE));
@@ -309,6 +309,26 @@ void mm_memdump(FAR struct mm_heap_s *heap,
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_STATISTICS
+  if (pid == PID_MM_FREE)
+    {
+      int i;
+
+      /* Summarize the fragmentation as a log2 histogram of the sizes */
+
+      syslog(LOG_INFO, "%12s%12s\n", "Size <", "Free Blks");
+      for (i = 0; i < MM_STAT_NBUCKETS; i++)
+        {
+          if (priv.freehist[i] != 0)
+            {
+              syslog(LOG_INFO, "%12lu%12lu\n",
+                     i < MM_STAT_NBUCKETS - 1 ? 1ul << i : ULONG_MAX,
+                     priv.freehist[i]);
+            }
+        }
+    }
+#endif
+
   syslog(LOG_INFO, "%12s%12s\n", "Total Blks", "Total Size");
   syslog(LOG_INFO, "%12d%12d\n", priv.info.aordblks, priv.info.uordblks);
 }
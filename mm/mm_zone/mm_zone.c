@@ -0,0 +1,496 @@
+/****************************************************************************
+ * mm/mm_zone/mm_zone.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <sys/param.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Zones can be attached to the user and to the kernel heap */
+
+#define MM_ZONE_NHOMES  2
+
+#define MM_ZONE_NORMAL_INDEX MM_ZONE_INDEX(MM_ZONE_NORMAL)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The zones of one home heap.  The slots are filled once at boot, the
+ * allocation paths read them without locking.
+ */
+
+struct mm_zone_s
+{
+  FAR struct mm_heap_s *home;                 /* Home heap, normal zone */
+  FAR struct mm_heap_s *heap[MM_NZONES];      /* Heap backing each zone */
+  atomic_t              allocs[MM_NZONES];    /* Allocations served */
+  atomic_t              fallbacks[MM_NZONES]; /* Allocations that missed */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mm_zone_s g_mm_zones[MM_ZONE_NHOMES];
+static spinlock_t g_mm_zone_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR struct mm_zone_s *mm_zone_find(FAR struct mm_heap_s *home)
+{
+  int i;
+
+  for (i = 0; i < MM_ZONE_NHOMES; i++)
+    {
+      if (g_mm_zones[i].home == home)
+        {
+          return &g_mm_zones[i];
+        }
+    }
+
+  return NULL;
+}
+
+/* Replace MM_ZONE_DEFAULT with the default zone of the calling task.  A
+ * task without an explicit default gets the fast zone when its priority is
+ * at least CONFIG_MM_HEAP_ZONE_FAST_PRIORITY.
+ */
+
+static int mm_zone_resolve(int zone)
+{
+  FAR struct tcb_s *tcb;
+
+  if ((zone & MM_ZONE_MASK) != MM_ZONE_DEFAULT)
+    {
+      return zone;
+    }
+
+  tcb = this_task();
+  if (tcb == NULL || up_interrupt_context())
+    {
+      return zone | MM_ZONE_NORMAL;
+    }
+
+  if ((tcb->mm_zone & MM_ZONE_MASK) != MM_ZONE_DEFAULT)
+    {
+      return zone | tcb->mm_zone;
+    }
+
+#if CONFIG_MM_HEAP_ZONE_FAST_PRIORITY > 0
+  if (tcb->sched_priority >= CONFIG_MM_HEAP_ZONE_FAST_PRIORITY)
+    {
+      return zone | tcb->mm_zone | MM_ZONE_FAST;
+    }
+#endif
+
+  return zone | tcb->mm_zone | MM_ZONE_NORMAL;
+}
+
+static FAR void *mm_zone_heapalloc(FAR struct mm_heap_s *heap,
+                                   size_t alignment, size_t size)
+{
+  if (alignment == 0)
+    {
+      return mm_malloc(heap, size);
+    }
+
+  return mm_memalign(heap, alignment, size);
+}
+
+static FAR void *mm_zone_alloc(FAR struct mm_heap_s *home, int zone,
+                               size_t alignment, size_t size)
+{
+  FAR struct mm_zone_s *zones;
+  FAR struct mm_heap_s *heap;
+  FAR void *mem;
+  int index;
+
+  zones = mm_zone_find(home);
+  if (zones == NULL)
+    {
+      return mm_zone_heapalloc(home, alignment, size);
+    }
+
+  zone  = mm_zone_resolve(zone);
+  index = MM_ZONE_INDEX(zone);
+  DEBUGASSERT(index >= 0 && index < MM_NZONES);
+
+  heap = zones->heap[index];
+  if (heap != NULL)
+    {
+      mem = mm_zone_heapalloc(heap, alignment, size);
+      if (mem != NULL)
+        {
+          atomic_fetch_add(&zones->allocs[index], 1);
+          return mem;
+        }
+    }
+
+  /* Only fall back to the normal zone, the other zones are too scarce to
+   * absorb the overflow of each other.
+   */
+
+  if (index == MM_ZONE_NORMAL_INDEX || (zone & MM_ZONE_STRICT) != 0)
+    {
+      return NULL;
+    }
+
+  atomic_fetch_add(&zones->fallbacks[index], 1);
+
+  mem = mm_zone_heapalloc(home, alignment, size);
+  if (mem != NULL)
+    {
+      atomic_fetch_add(&zones->allocs[MM_ZONE_NORMAL_INDEX], 1);
+    }
+
+  return mem;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_zone_register
+ *
+ * Description:
+ *   Attach a heap, typically created with mm_initialize() on a memory
+ *   region with special properties, as a zone of a home heap.  Memory
+ *   allocated from the zone must be released through the home heap
+ *   interfaces, i.e. free() or kmm_free().
+ *
+ * Input Parameters:
+ *   home - The user or the kernel heap.
+ *   zone - The zone the heap backs, MM_ZONE_FAST, ...
+ *   heap - The heap to attach.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mm_zone_register(FAR struct mm_heap_s *home, int zone,
+                     FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_zone_s *zones;
+  irqstate_t flags;
+  int index = MM_ZONE_INDEX(zone);
+  int ret = OK;
+
+  if (home == NULL || heap == NULL || heap == home ||
+      index <= MM_ZONE_NORMAL_INDEX || index >= MM_NZONES)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_zone_lock);
+
+  zones = mm_zone_find(home);
+  if (zones == NULL)
+    {
+      zones = mm_zone_find(NULL);
+      if (zones == NULL)
+        {
+          ret = -ENOMEM;
+          goto out;
+        }
+
+      zones->heap[MM_ZONE_NORMAL_INDEX] = home;
+    }
+
+  if (zones->heap[index] != NULL)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
+  /* Publish the zone before the home heap, the readers don't lock */
+
+  zones->heap[index] = heap;
+  UP_DMB();
+  zones->home = home;
+
+out:
+  spin_unlock_irqrestore(&g_mm_zone_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_zone_heap
+ *
+ * Description:
+ *   Return the heap, among a home heap and its zones, that owns a memory
+ *   block.  The home heap is returned for any block not in a zone.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *mm_zone_heap(FAR struct mm_heap_s *home,
+                                   FAR void *mem)
+{
+  FAR struct mm_zone_s *zones;
+  int i;
+
+  if (mem == NULL || (zones = mm_zone_find(home)) == NULL)
+    {
+      return home;
+    }
+
+  for (i = MM_ZONE_NORMAL_INDEX + 1; i < MM_NZONES; i++)
+    {
+      if (zones->heap[i] != NULL && mm_heapmember(zones->heap[i], mem))
+        {
+          return zones->heap[i];
+        }
+    }
+
+  return home;
+}
+
+/****************************************************************************
+ * Name: mm_zone_malloc
+ *
+ * Description:
+ *   Allocate memory from a zone of a home heap.  MM_ZONE_DEFAULT selects
+ *   the default zone of the calling task.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zone_malloc(FAR struct mm_heap_s *home, int zone, size_t size)
+{
+  return mm_zone_alloc(home, zone, 0, size);
+}
+
+/****************************************************************************
+ * Name: mm_zone_memalign
+ *
+ * Description:
+ *   Allocate aligned memory from a zone of a home heap.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zone_memalign(FAR struct mm_heap_s *home, int zone,
+                           size_t alignment, size_t size)
+{
+  return mm_zone_alloc(home, zone, alignment, size);
+}
+
+/****************************************************************************
+ * Name: mm_zone_zalloc
+ *
+ * Description:
+ *   Allocate zeroed memory from a zone of a home heap.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zone_zalloc(FAR struct mm_heap_s *home, int zone, size_t size)
+{
+  FAR void *mem = mm_zone_alloc(home, zone, 0, size);
+
+  if (mem != NULL)
+    {
+      memset(mem, 0, size);
+    }
+
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_zone_calloc
+ *
+ * Description:
+ *   Allocate a zeroed array from a zone of a home heap.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zone_calloc(FAR struct mm_heap_s *home, int zone, size_t n,
+                         size_t elem_size)
+{
+  if (elem_size != 0 && n > (SIZE_MAX / elem_size))
+    {
+      return NULL;
+    }
+
+  return mm_zone_zalloc(home, zone, n * elem_size);
+}
+
+/****************************************************************************
+ * Name: mm_zone_realloc
+ *
+ * Description:
+ *   Resize a block of a home heap or of one of its zones.  The block stays
+ *   in its zone when possible, otherwise it moves to the normal zone.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zone_realloc(FAR struct mm_heap_s *home, FAR void *oldmem,
+                          size_t size)
+{
+  FAR struct mm_heap_s *heap;
+  FAR void *mem;
+
+  if (oldmem == NULL)
+    {
+      return mm_zone_alloc(home, MM_ZONE_DEFAULT, 0, size);
+    }
+
+  heap = mm_zone_heap(home, oldmem);
+  mem  = mm_realloc(heap, oldmem, size);
+  if (mem != NULL || heap == home || size == 0)
+    {
+      return mem;
+    }
+
+  mem = mm_malloc(home, size);
+  if (mem != NULL)
+    {
+      memcpy(mem, oldmem, MIN(size, mm_malloc_size(heap, oldmem)));
+      mm_free(heap, oldmem);
+    }
+
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_zone_settask
+ *
+ * Description:
+ *   Set the zone that malloc() and friends use for a task.  MM_ZONE_STRICT
+ *   may be or-ed in to disable the fall back.
+ *
+ * Input Parameters:
+ *   pid  - The task, zero for the calling task.
+ *   zone - The default zone; MM_ZONE_DEFAULT restores the automatic
+ *          placement by priority.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mm_zone_settask(pid_t pid, int zone)
+{
+  FAR struct tcb_s *tcb;
+
+  if ((zone & ~(MM_ZONE_MASK | MM_ZONE_STRICT)) != 0 ||
+      MM_ZONE_INDEX(zone) >= MM_NZONES)
+    {
+      return -EINVAL;
+    }
+
+  tcb = pid == 0 ? this_task() : nxsched_get_tcb(pid);
+  if (tcb == NULL)
+    {
+      return -ESRCH;
+    }
+
+  tcb->mm_zone = zone;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mm_zone_gettask
+ *
+ * Description:
+ *   Return the zone set for a task with mm_zone_settask(), zero for the
+ *   calling task, or a negated errno value.
+ *
+ ****************************************************************************/
+
+int mm_zone_gettask(pid_t pid)
+{
+  FAR struct tcb_s *tcb;
+
+  tcb = pid == 0 ? this_task() : nxsched_get_tcb(pid);
+  if (tcb == NULL)
+    {
+      return -ESRCH;
+    }
+
+  return tcb->mm_zone;
+}
+
+/****************************************************************************
+ * Name: mm_zoneinfo
+ *
+ * Description:
+ *   Report the usage of the registered zones, one per index starting at
+ *   zero, the normal zones included.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT past the last zone.
+ *
+ ****************************************************************************/
+
+int mm_zoneinfo(int index, FAR struct mm_zoneinfo_s *info)
+{
+  FAR struct mm_zone_s *zones;
+  int i;
+  int j;
+
+  for (i = 0; i < MM_ZONE_NHOMES; i++)
+    {
+      zones = &g_mm_zones[i];
+      if (zones->home == NULL)
+        {
+          continue;
+        }
+
+      for (j = 0; j < MM_NZONES; j++)
+        {
+          if (zones->heap[j] == NULL || index-- > 0)
+            {
+              continue;
+            }
+
+          info->home      = zones->home;
+          info->heap      = zones->heap[j];
+          info->zone      = j + 1;
+          info->allocs    = atomic_read(&zones->allocs[j]);
+          info->fallbacks = atomic_read(&zones->fallbacks[j]);
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
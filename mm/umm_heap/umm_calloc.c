@@ -73,7 +73,7 @@ FAR void *calloc(size_t n, size_t elem_size)
 #else
   /* Use mm_calloc() because it implements the clear */
 
-  FAR void *mem = mm_calloc(USR_HEAP, n, elem_size);
+  FAR void *mem = mm_zone_calloc(USR_HEAP, MM_ZONE_DEFAULT, n, elem_size);
 
   if (mem == NULL)
     {
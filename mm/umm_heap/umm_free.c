@@ -48,5 +48,5 @@
 #undef free /* See mm/README.txt */
 void free(FAR void *mem)
 {
-  mm_free(USR_HEAP, mem);
+  mm_free(mm_zone_heap(USR_HEAP, mem), mem);
 }
@@ -52,5 +52,5 @@
 
 bool umm_heapmember(FAR void *mem)
 {
-  return mm_heapmember(USR_HEAP, mem);
+  return mm_heapmember(mm_zone_heap(USR_HEAP, mem), mem);
 }
@@ -63,7 +63,7 @@ FAR void *malloc(size_t size)
 
   /* Use mm_malloc() because it implements the clear */
 
-  ret = mm_malloc(USR_HEAP, size);
+  ret = mm_zone_malloc(USR_HEAP, MM_ZONE_DEFAULT, size);
   if (ret == NULL)
     {
       set_errno(ENOMEM);
@@ -39,5 +39,5 @@
 #undef malloc_size /* See mm/README.txt */
 size_t malloc_size(FAR void *mem)
 {
-  return mm_malloc_size(USR_HEAP, mem);
+  return mm_malloc_size(mm_zone_heap(USR_HEAP, mem), mem);
 }
@@ -90,7 +90,7 @@ FAR void *memalign(size_t alignment, size_t size)
 #else
   FAR void *ret;
 
-  ret = mm_memalign(USR_HEAP, alignment, size);
+  ret = mm_zone_memalign(USR_HEAP, MM_ZONE_DEFAULT, alignment, size);
   if (ret == NULL)
     {
       set_errno(ENOMEM);
@@ -92,7 +92,7 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 #else
   FAR void *ret;
 
-  ret = mm_realloc(USR_HEAP, oldmem, size);
+  ret = mm_zone_realloc(USR_HEAP, oldmem, size);
   if (ret == NULL)
     {
       set_errno(ENOMEM);
@@ -69,7 +69,7 @@ FAR void *zalloc(size_t size)
 
   /* Use mm_zalloc() because it implements the clear */
 
-  ret = mm_zalloc(USR_HEAP, size);
+  ret = mm_zone_zalloc(USR_HEAP, MM_ZONE_DEFAULT, size);
   if (ret == NULL)
     {
       set_errno(ENOMEM);
@@ -500,6 +500,29 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
                     unsigned int target_offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_ref_send
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_file_send() except that the data is
+ *   not copied:  The packet references it in a reference counted external
+ *   buffer, e.g. the file data mapped in memory.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+struct iob_ref_s;
+int devif_ref_send(FAR struct net_driver_s *dev, FAR struct iob_ref_s *ref,
+                   FAR const uint8_t *data, unsigned int len,
+                   unsigned int target_offset);
+#endif
+
 /****************************************************************************
  * Name: devif_out
  *
@@ -163,4 +163,90 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: devif_ref_send
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_file_send() except that the data is
+ *   not copied:  The packet references it in a reference counted external
+ *   buffer, e.g. the file data mapped in memory.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+int devif_ref_send(FAR struct net_driver_s *dev, FAR struct iob_ref_s *ref,
+                   FAR const uint8_t *data, unsigned int len,
+                   unsigned int target_offset)
+{
+  FAR struct iob_s *head;
+  FAR struct iob_s *iob;
+  int ret;
+
+  if (dev == NULL)
+    {
+      ret = -ENODEV;
+      goto errout;
+    }
+
+  if (len == 0 || len > UINT16_MAX)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+#ifndef CONFIG_NET_IPFRAG
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+    {
+      ret = -EMSGSIZE;
+      goto errout;
+    }
+#endif
+
+  /* The headers get a buffer of their own, sized so that it is full and
+   * the data follows them directly in the chain.
+   */
+
+  head = iob_alloc_dynamic(CONFIG_NET_LL_GUARDSIZE + target_offset);
+  if (head == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  iob = iob_alloc_with_ref(data, len, ref);
+  if (iob == NULL)
+    {
+      iob_free(head);
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  iob_reserve(head, CONFIG_NET_LL_GUARDSIZE);
+  head->io_len     = target_offset;
+  head->io_flink   = iob;
+  head->io_pktlen  = target_offset + len;
+  iob->io_pktlen   = 0;
+
+  netdev_iob_replace(dev, head);
+
+  dev->d_sndlen = len;
+  return len;
+
+errout:
+  if (dev != NULL)
+    {
+      netdev_iob_release(dev);
+    }
+
+  nerr("ERROR: devif_ref_send error: %d\n", ret);
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_MM_IOB */
@@ -31,6 +31,7 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/lib/math32.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 
@@ -59,6 +60,7 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                    unsigned int len, unsigned int offset,
                    unsigned int target_offset)
 {
+  unsigned int need;
   int ret;
 
   if (dev == NULL)
@@ -74,19 +76,31 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
     }
 
 #ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset &&
+      NETDEV_GSOSIZE(dev) == 0)
     {
       ret = -EMSGSIZE;
       goto errout;
     }
 #endif
 
-  /* Append the send buffer after device buffer */
+  /* Append the send buffer after device buffer, the buffers beyond the
+   * device buffer are allocated together with one acquisition of the IOB
+   * lock.
+   */
 
-  if (len > iob_navail(false) * CONFIG_IOB_BUFSIZE)
+  need = dev->d_iob->io_offset + target_offset + len;
+  if (dev->d_iob->io_flink == NULL && need > IOB_BUFSIZE(dev->d_iob))
     {
-      ret = -ENOMEM;
-      goto errout;
+      dev->d_iob->io_flink =
+        iob_tryalloc_chain(false, div_round_up(need -
+                                               IOB_BUFSIZE(dev->d_iob),
+                                               CONFIG_IOB_BUFSIZE));
+      if (dev->d_iob->io_flink == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
     }
 
   /* Clone the iob to target device buffer */
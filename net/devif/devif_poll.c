@@ -30,6 +30,7 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/net.h>
@@ -618,6 +619,74 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 }
 #endif /* NET_UDP_HAVE_STACK */
 
+/****************************************************************************
+ * Name: devif_poll_udp_txready
+ *
+ * Description:
+ *   Poll the UDP connections with pending TX work on this device.  A
+ *   connection leaves the queue when it has nothing more to send.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NETDEV_TXREADY)
+static int devif_poll_udp_txready(FAR struct net_driver_s *dev,
+                                  devif_poll_callback_t callback)
+{
+  FAR struct udp_conn_s *conn;
+  FAR dq_entry_t *entry = dev->d_udpready.head;
+  FAR dq_entry_t *prev = NULL;
+  FAR dq_entry_t *next;
+  int bstop = 0;
+
+  while (!bstop && entry != NULL)
+    {
+      conn = container_of(entry, struct udp_conn_s, txready_node);
+
+      /* Perform the UDP TX poll */
+
+      udp_poll(dev, conn);
+
+      /* Perform any necessary conversions on outgoing packets */
+
+      devif_packet_conversion(dev, DEVIF_UDP);
+
+      /* Unless the poll freed the connection, it stays in the queue only
+       * if it may have more to send.
+       */
+
+      next = prev != NULL ? prev->flink : dev->d_udpready.head;
+      if (next == entry)
+        {
+          next = entry->flink;
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+          if (dev->d_len == 0 && sq_empty(&conn->write_q))
+#else
+          if (dev->d_len == 0)
+#endif
+            {
+              udp_txready_remove(conn);
+            }
+          else
+            {
+              prev = entry;
+            }
+        }
+
+      entry = next;
+
+      /* Call back into the driver */
+
+      bstop = devif_poll_local_out(dev, callback);
+    }
+
+  return bstop;
+}
+#endif
+
 /****************************************************************************
  * Name: devif_poll_tcp_connections
  *
@@ -665,6 +734,71 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 #  define devif_poll_tcp_connections(dev, callback) (0)
 #endif
 
+/****************************************************************************
+ * Name: devif_poll_tcp_txready
+ *
+ * Description:
+ *   Poll the TCP connections with pending TX work on this device.  A
+ *   connection leaves the queue when it has nothing more to send.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NETDEV_TXREADY)
+static int devif_poll_tcp_txready(FAR struct net_driver_s *dev,
+                                  devif_poll_callback_t callback)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry = dev->d_tcpready.head;
+  FAR dq_entry_t *prev = NULL;
+  FAR dq_entry_t *next;
+  int bstop = 0;
+
+  while (!bstop && entry != NULL)
+    {
+      conn = container_of(entry, struct tcp_conn_s, txready_node);
+
+      /* Perform the TCP TX poll */
+
+      tcp_poll(dev, conn);
+
+      /* Perform any necessary conversions on outgoing packets */
+
+      devif_packet_conversion(dev, DEVIF_TCP);
+
+      /* Unless the poll freed the connection, it stays in the queue only
+       * if it may have more to send.  A poll that could not get an IOB
+       * did not look at the connection at all.
+       */
+
+      next = prev != NULL ? prev->flink : dev->d_tcpready.head;
+      if (next == entry)
+        {
+          next = entry->flink;
+          if (dev->d_len == 0 && dev->d_iob != NULL)
+            {
+              tcp_txready_remove(conn);
+            }
+          else
+            {
+              prev = entry;
+            }
+        }
+
+      entry = next;
+
+      /* Call back into the driver */
+
+      bstop = devif_poll_local_out(dev, callback);
+    }
+
+  return bstop;
+}
+#endif
+
 /****************************************************************************
  * Name: devif_poll_ipfrag
  *
@@ -684,7 +818,7 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_IPFRAG
+#if defined(CONFIG_NET_IPFRAG) || defined(CONFIG_NET_TCP_TSO)
 static int devif_poll_ipfrag(FAR struct net_driver_s *dev,
                              devif_poll_callback_t callback)
 {
@@ -741,6 +875,64 @@ static int devif_poll_ipfrag(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: devif_poll_tso
+ *
+ * Description:
+ *   Send a large TCP packet, one with d_gsosize set.  A driver that
+ *   segments in hardware gets the packet as it is, otherwise the packet is
+ *   cut into segments that are sent like IP fragments.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TSO
+static int devif_poll_tso(FAR struct net_driver_s *dev,
+                          devif_poll_callback_t callback)
+{
+  int bstop = 0;
+
+  /* A packet to ourselves goes up the stack as it is */
+
+  if (callback == NULL || devif_is_loopback(dev))
+    {
+      dev->d_gsosize = 0;
+      return devif_poll_out(dev, callback);
+    }
+
+  if (dev->d_tsomax == 0)
+    {
+      if (tcp_tso_segment(dev) != OK)
+        {
+          netdev_iob_release(dev);
+          return 1;
+        }
+
+      return devif_poll_ipfrag(dev, callback);
+    }
+
+  devif_out(dev);
+
+  if (dev->d_len > 0)
+    {
+      /* The packet may have been replaced by an ARP request */
+
+      if (dev->d_len <= NETDEV_PKTSIZE(dev))
+        {
+          dev->d_gsosize = 0;
+        }
+
+      bstop = callback(dev);
+    }
+
+  dev->d_gsosize = 0;
+  return bstop;
+}
+#endif
+
 /****************************************************************************
  * Name: devif_poll_connections
  *
@@ -779,7 +971,7 @@ static int devif_poll_connections(FAR struct net_driver_s *dev,
    * action.
    */
 
-#ifdef CONFIG_NET_IPFRAG
+#if defined(CONFIG_NET_IPFRAG) || defined(CONFIG_NET_TCP_TSO)
   /* Traverse all of ip fragments for available packets to transfer */
 
   bstop = devif_poll_ipfrag(dev, callback);
@@ -854,7 +1046,11 @@ static int devif_poll_connections(FAR struct net_driver_s *dev,
        * action.
        */
 
+#ifdef CONFIG_NETDEV_TXREADY
+      bstop = devif_poll_tcp_txready(dev, callback);
+#else
       bstop = devif_poll_tcp_connections(dev, callback);
+#endif
     }
 
   if (!bstop)
@@ -865,7 +1061,11 @@ static int devif_poll_connections(FAR struct net_driver_s *dev,
        * the poll action
        */
 
+#ifdef CONFIG_NETDEV_TXREADY
+      bstop = devif_poll_udp_txready(dev, callback);
+#else
       bstop = devif_poll_udp_connections(dev, callback);
+#endif
     }
 
   if (!bstop)
@@ -1165,9 +1365,19 @@ int devif_poll_out(FAR struct net_driver_s *dev,
 
   if (dev->d_len == 0)
     {
+#ifdef CONFIG_NET_TCP_TSO
+      dev->d_gsosize = 0;
+#endif
       return 0;
     }
 
+#ifdef CONFIG_NET_TCP_TSO
+  if (dev->d_gsosize != 0)
+    {
+      return devif_poll_tso(dev, callback);
+    }
+#endif
+
   devif_out(dev);
 
   bstop = devif_loopback(dev);
@@ -46,6 +46,13 @@
 static DECLARE_HASHTABLE(g_nat44_inbound, CONFIG_NET_NAT_HASH_BITS);
 static DECLARE_HASHTABLE(g_nat44_outbound, CONFIG_NET_NAT_HASH_BITS);
 
+/* The entries of each protocol, in the order of their expiration.  All the
+ * entries of a protocol have the same idle timeout, so a refreshed entry
+ * always moves to the tail and the expired entries are at the head.
+ */
+
+static dq_queue_t g_nat44_expire[NAT_EXPIRE_NQUEUES];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -76,10 +83,22 @@ static inline uint32_t ipv4_nat_inbound_key(in_addr_t external_ip,
 
 static inline uint32_t ipv4_nat_outbound_key(in_addr_t local_ip,
                                              uint16_t local_port,
+                                             in_addr_t peer_ip,
+                                             uint16_t peer_port,
                                              uint8_t protocol)
 {
-  return NTOHL(local_ip) ^ /* NTOHL makes sure difference is in lower bits. */
-         ((uint32_t)protocol << 8) ^ ((uint32_t)local_port << 16);
+  /* NTOHL makes sure difference is in lower bits. */
+
+  uint32_t key = NTOHL(local_ip) ^ ((uint32_t)protocol << 8) ^
+                 ((uint32_t)local_port << 16);
+
+#ifdef CONFIG_NET_NAT44_SYMMETRIC
+  /* A local port has one entry per peer, tell them apart */
+
+  key ^= NAT_HASH_ROTATE(NTOHL(peer_ip)) ^ peer_port;
+#endif
+
+  return key;
 }
 
 /****************************************************************************
@@ -95,7 +114,15 @@ static inline uint32_t ipv4_nat_outbound_key(in_addr_t local_ip,
 
 static void ipv4_nat_entry_refresh(FAR ipv4_nat_entry_t *entry)
 {
-  entry->expire_time = nat_expire_time(entry->protocol);
+  FAR dq_queue_t *queue = &g_nat44_expire[NAT_EXPIRE_QUEUE(entry->protocol)];
+  int32_t expire_time = nat_expire_time(entry->protocol);
+
+  if (entry->expire_time != expire_time)
+    {
+      entry->expire_time = expire_time;
+      dq_rem(&entry->expire_node, queue);
+      dq_addlast(&entry->expire_node, queue);
+    }
 }
 
 /****************************************************************************
@@ -141,12 +168,15 @@ ipv4_nat_entry_create(uint8_t protocol,
   entry->peer_port     = peer_port;
 #endif
 
-  ipv4_nat_entry_refresh(entry);
+  entry->expire_time   = nat_expire_time(protocol);
 
+  dq_addlast(&entry->expire_node,
+             &g_nat44_expire[NAT_EXPIRE_QUEUE(protocol)]);
   hashtable_add(g_nat44_inbound, &entry->hash_inbound,
                 ipv4_nat_inbound_key(external_ip, external_port, protocol));
   hashtable_add(g_nat44_outbound, &entry->hash_outbound,
-                ipv4_nat_outbound_key(local_ip, local_port, protocol));
+                ipv4_nat_outbound_key(local_ip, local_port, peer_ip,
+                                      peer_port, protocol));
 
 #ifdef CONFIG_NETLINK_NETFILTER
   netlink_conntrack_notify(IPCTNL_MSG_CT_NEW, PF_INET, entry);
@@ -180,7 +210,15 @@ static void ipv4_nat_entry_delete(FAR ipv4_nat_entry_t *entry)
   hashtable_delete(g_nat44_outbound, &entry->hash_outbound,
                    ipv4_nat_outbound_key(entry->local_ip,
                                          entry->local_port,
+#ifdef CONFIG_NET_NAT44_SYMMETRIC
+                                         entry->peer_ip,
+                                         entry->peer_port,
+#else
+                                         INADDR_ANY, 0,
+#endif
                                          entry->protocol));
+  dq_rem(&entry->expire_node,
+         &g_nat44_expire[NAT_EXPIRE_QUEUE(entry->protocol)]);
 
 #ifdef CONFIG_NETLINK_NETFILTER
   netlink_conntrack_notify(IPCTNL_MSG_CT_DELETE, PF_INET, entry);
@@ -193,44 +231,34 @@ static void ipv4_nat_entry_delete(FAR ipv4_nat_entry_t *entry)
  * Name: ipv4_nat_reclaim_entry
  *
  * Description:
- *   Try reclaim all expired NAT entries.
- *   Only works after every CONFIG_NET_NAT_ENTRY_RECLAIM_SEC (low frequency).
- *
- *   Although expired entries will be automatically reclaimed when matching
- *   inbound/outbound entries, there might be some situations that entries
- *   will be kept in memory, e.g. big hashtable with only a few connections.
+ *   Delete the expired NAT entries.  They are at the head of the expiration
+ *   lists, so this only visits the entries to delete.
  *
  * Assumptions:
  *   NAT is initialized.
  *
  ****************************************************************************/
 
-#if CONFIG_NET_NAT_ENTRY_RECLAIM_SEC > 0
-static void ipv4_nat_reclaim_entry_cb(FAR ipv4_nat_entry_t *entry,
-                                      FAR void *arg)
-{
-  int32_t current_time = *(FAR int32_t *)arg;
-
-  if (entry->expire_time - current_time <= 0)
-    {
-      ipv4_nat_entry_delete(entry);
-    }
-}
-
 static void ipv4_nat_reclaim_entry(int32_t current_time)
 {
-  static int32_t next_reclaim_time = CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
+  FAR ipv4_nat_entry_t *entry;
+  FAR dq_entry_t *node;
+  int i;
 
-  if (next_reclaim_time - current_time <= 0)
+  for (i = 0; i < NAT_EXPIRE_NQUEUES; i++)
     {
-      ninfo("INFO: Reclaiming all expired NAT44 entries.\n");
-      ipv4_nat_entry_foreach(ipv4_nat_reclaim_entry_cb, &current_time);
-      next_reclaim_time = current_time + CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
+      while ((node = dq_peek(&g_nat44_expire[i])) != NULL)
+        {
+          entry = container_of(node, ipv4_nat_entry_t, expire_node);
+          if (entry->expire_time - current_time > 0)
+            {
+              break;
+            }
+
+          ipv4_nat_entry_delete(entry);
+        }
     }
 }
-#else
-#  define ipv4_nat_reclaim_entry(t)
-#endif
 
 /****************************************************************************
  * Name: ipv4_nat_entry_clear_cb
@@ -344,14 +372,6 @@ ipv4_nat_inbound_entry_find(uint8_t protocol, in_addr_t external_ip,
       FAR ipv4_nat_entry_t *entry =
         container_of(p, ipv4_nat_entry_t, hash_inbound);
 
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv4_nat_entry_delete(entry);
-          continue;
-        }
-
       if (entry->protocol == protocol &&
           (skip_ip || net_ipv4addr_cmp(entry->external_ip, external_ip)) &&
           entry->external_port == external_port
@@ -415,19 +435,12 @@ ipv4_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
   ipv4_nat_reclaim_entry(current_time);
 
   hashtable_for_every_possible_safe(g_nat44_outbound, p, tmp,
-                      ipv4_nat_outbound_key(local_ip, local_port, protocol))
+                      ipv4_nat_outbound_key(local_ip, local_port, peer_ip,
+                                            peer_port, protocol))
     {
       FAR ipv4_nat_entry_t *entry =
         container_of(p, ipv4_nat_entry_t, hash_outbound);
 
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv4_nat_entry_delete(entry);
-          continue;
-        }
-
       if (entry->protocol == protocol &&
           net_ipv4addr_cmp(entry->external_ip, dev->d_ipaddr) &&
           net_ipv4addr_cmp(entry->local_ip, local_ip) &&
@@ -47,6 +47,13 @@
 static DECLARE_HASHTABLE(g_nat66_inbound, CONFIG_NET_NAT_HASH_BITS);
 static DECLARE_HASHTABLE(g_nat66_outbound, CONFIG_NET_NAT_HASH_BITS);
 
+/* The entries of each protocol, in the order of their expiration.  All the
+ * entries of a protocol have the same idle timeout, so a refreshed entry
+ * always moves to the tail and the expired entries are at the head.
+ */
+
+static dq_queue_t g_nat66_expire[NAT_EXPIRE_NQUEUES];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -70,6 +77,31 @@ static inline uint32_t ipv6_nat_hash_key(const net_ipv6addr_t ip,
   return key ^ ((uint32_t)protocol << 16) ^ port;
 }
 
+/****************************************************************************
+ * Name: ipv6_nat_outbound_key
+ *
+ * Description:
+ *   Create an outbound hash key for NAT66.
+ *
+ ****************************************************************************/
+
+static inline uint32_t ipv6_nat_outbound_key(const net_ipv6addr_t local_ip,
+                                             uint16_t local_port,
+                                             const net_ipv6addr_t peer_ip,
+                                             uint16_t peer_port,
+                                             uint8_t protocol)
+{
+  uint32_t key = ipv6_nat_hash_key(local_ip, local_port, protocol);
+
+#ifdef CONFIG_NET_NAT66_SYMMETRIC
+  /* A local port has one entry per peer, tell them apart */
+
+  key ^= NAT_HASH_ROTATE(ipv6_nat_hash_key(peer_ip, peer_port, 0));
+#endif
+
+  return key;
+}
+
 /****************************************************************************
  * Name: ipv6_nat_entry_refresh
  *
@@ -83,7 +115,15 @@ static inline uint32_t ipv6_nat_hash_key(const net_ipv6addr_t ip,
 
 static void ipv6_nat_entry_refresh(FAR ipv6_nat_entry_t *entry)
 {
-  entry->expire_time = nat_expire_time(entry->protocol);
+  FAR dq_queue_t *queue = &g_nat66_expire[NAT_EXPIRE_QUEUE(entry->protocol)];
+  int32_t expire_time = nat_expire_time(entry->protocol);
+
+  if (entry->expire_time != expire_time)
+    {
+      entry->expire_time = expire_time;
+      dq_rem(&entry->expire_node, queue);
+      dq_addlast(&entry->expire_node, queue);
+    }
 }
 
 /****************************************************************************
@@ -131,12 +171,15 @@ ipv6_nat_entry_create(uint8_t protocol, const net_ipv6addr_t external_ip,
   net_ipv6addr_copy(entry->peer_ip, peer_ip);
 #endif
 
-  ipv6_nat_entry_refresh(entry);
+  entry->expire_time   = nat_expire_time(protocol);
 
+  dq_addlast(&entry->expire_node,
+             &g_nat66_expire[NAT_EXPIRE_QUEUE(protocol)]);
   hashtable_add(g_nat66_inbound, &entry->hash_inbound,
                 ipv6_nat_hash_key(external_ip, external_port, protocol));
   hashtable_add(g_nat66_outbound, &entry->hash_outbound,
-                ipv6_nat_hash_key(local_ip, local_port, protocol));
+                ipv6_nat_outbound_key(local_ip, local_port, peer_ip,
+                                      peer_port, protocol));
 
 #ifdef CONFIG_NETLINK_NETFILTER
   netlink_conntrack_notify(IPCTNL_MSG_CT_NEW, PF_INET6, entry);
@@ -171,9 +214,17 @@ static void ipv6_nat_entry_delete(FAR ipv6_nat_entry_t *entry)
                                      entry->external_port,
                                      entry->protocol));
   hashtable_delete(g_nat66_outbound, &entry->hash_outbound,
-                   ipv6_nat_hash_key(entry->local_ip,
-                                     entry->local_port,
-                                     entry->protocol));
+                   ipv6_nat_outbound_key(entry->local_ip,
+                                         entry->local_port,
+#ifdef CONFIG_NET_NAT66_SYMMETRIC
+                                         entry->peer_ip,
+                                         entry->peer_port,
+#else
+                                         g_ipv6_unspecaddr, 0,
+#endif
+                                         entry->protocol));
+  dq_rem(&entry->expire_node,
+         &g_nat66_expire[NAT_EXPIRE_QUEUE(entry->protocol)]);
 
 #ifdef CONFIG_NETLINK_NETFILTER
   netlink_conntrack_notify(IPCTNL_MSG_CT_DELETE, PF_INET6, entry);
@@ -186,44 +237,34 @@ static void ipv6_nat_entry_delete(FAR ipv6_nat_entry_t *entry)
  * Name: ipv6_nat_reclaim_entry
  *
  * Description:
- *   Try reclaim all expired NAT entries.
- *   Only works after every CONFIG_NET_NAT_ENTRY_RECLAIM_SEC (low frequency).
- *
- *   Although expired entries will be automatically reclaimed when matching
- *   inbound/outbound entries, there might be some situations that entries
- *   will be kept in memory, e.g. big hashtable with only a few connections.
+ *   Delete the expired NAT entries.  They are at the head of the expiration
+ *   lists, so this only visits the entries to delete.
  *
  * Assumptions:
  *   NAT is initialized.
  *
  ****************************************************************************/
 
-#if CONFIG_NET_NAT_ENTRY_RECLAIM_SEC > 0
-static void ipv6_nat_reclaim_entry_cb(FAR ipv6_nat_entry_t *entry,
-                                      FAR void *arg)
-{
-  int32_t current_time = *(FAR int32_t *)arg;
-
-  if (entry->expire_time - current_time <= 0)
-    {
-      ipv6_nat_entry_delete(entry);
-    }
-}
-
 static void ipv6_nat_reclaim_entry(int32_t current_time)
 {
-  static int32_t next_reclaim_time = CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
+  FAR ipv6_nat_entry_t *entry;
+  FAR dq_entry_t *node;
+  int i;
 
-  if (next_reclaim_time - current_time <= 0)
+  for (i = 0; i < NAT_EXPIRE_NQUEUES; i++)
     {
-      ninfo("INFO: Reclaiming all expired NAT66 entries.\n");
-      ipv6_nat_entry_foreach(ipv6_nat_reclaim_entry_cb, &current_time);
-      next_reclaim_time = current_time + CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
+      while ((node = dq_peek(&g_nat66_expire[i])) != NULL)
+        {
+          entry = container_of(node, ipv6_nat_entry_t, expire_node);
+          if (entry->expire_time - current_time > 0)
+            {
+              break;
+            }
+
+          ipv6_nat_entry_delete(entry);
+        }
     }
 }
-#else
-#  define ipv6_nat_reclaim_entry(t)
-#endif
 
 /****************************************************************************
  * Name: ipv6_nat_entry_clear_cb
@@ -339,14 +380,6 @@ ipv6_nat_inbound_entry_find(uint8_t protocol,
       FAR ipv6_nat_entry_t *entry =
         container_of(p, ipv6_nat_entry_t, hash_inbound);
 
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv6_nat_entry_delete(entry);
-          continue;
-        }
-
       if (entry->protocol == protocol &&
           (skip_ip || net_ipv6addr_cmp(entry->external_ip, external_ip)) &&
           entry->external_port == external_port
@@ -415,19 +448,13 @@ ipv6_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
   ipv6_nat_reclaim_entry(current_time);
 
   hashtable_for_every_possible_safe(g_nat66_outbound, p, tmp,
-                          ipv6_nat_hash_key(local_ip, local_port, protocol))
+                          ipv6_nat_outbound_key(local_ip, local_port,
+                                                peer_ip, peer_port,
+                                                protocol))
     {
       FAR ipv6_nat_entry_t *entry =
         container_of(p, ipv6_nat_entry_t, hash_outbound);
 
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv6_nat_entry_delete(entry);
-          continue;
-        }
-
       if (entry->protocol == protocol &&
           NETDEV_IS_MY_V6ADDR(dev, entry->external_ip) &&
           net_ipv6addr_cmp(entry->local_ip, local_ip) &&
@@ -66,6 +66,18 @@
 #define PEER_PORT(l4hdr,manip_type) \
   ((manip_type) != NAT_MANIP_SRC ? &(l4hdr)->srcport : &(l4hdr)->destport)
 
+/* The entries are kept in one expiration list per idle timeout:  TCP, UDP
+ * and ICMP or ICMPv6.
+ */
+
+#define NAT_EXPIRE_NQUEUES 3
+#define NAT_EXPIRE_QUEUE(protocol) \
+  ((protocol) == IP_PROTO_TCP ? 0 : (protocol) == IP_PROTO_UDP ? 1 : 2)
+
+/* Swap the halves of a 32-bit value before mixing it into a hash key */
+
+#define NAT_HASH_ROTATE(x) (((uint32_t)(x) << 16) | ((uint32_t)(x) >> 16))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -74,6 +86,7 @@ struct ipv4_nat_entry_s
 {
   hash_node_t hash_inbound;
   hash_node_t hash_outbound;
+  dq_entry_t  expire_node;   /* Link in the expiration list */
 
   /*  Local Network                             External Network
    *                |----------------|
@@ -106,6 +119,7 @@ struct ipv6_nat_entry_s
 {
   hash_node_t    hash_inbound;
   hash_node_t    hash_outbound;
+  dq_entry_t     expire_node;   /* Link in the expiration list */
 
   net_ipv6addr_t local_ip;      /* IP address of the local host. */
   net_ipv6addr_t external_ip;   /* External IP address. */
@@ -53,7 +53,7 @@ extern "C"
 #endif
 
 /* List of registered Ethernet device drivers.  You must have the network
- * locked in order to access this list.
+ * locked, or hold netdev_list_rlock(), in order to access this list.
  *
  * NOTE that this duplicates a declaration in net/tcp/tcp.h
  */
@@ -93,6 +93,27 @@ typedef int (*netdev_callback_t)(FAR struct net_driver_s *dev,
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_list_lock, netdev_list_rlock, netdev_list_unlock and
+ *       netdev_list_runlock
+ *
+ * Description:
+ *   Read-mostly protection of the list of network devices.  The list is
+ *   only modified with both the network lock and the write lock held, so
+ *   that lookups may walk it holding either the network lock or the read
+ *   lock.  The network lock is always taken first.
+ *
+ *   netdev_list_rlock() takes nothing if the caller holds the network
+ *   lock, so a reader must not take or release the network lock before
+ *   netdev_list_runlock().
+ *
+ ****************************************************************************/
+
+void netdev_list_lock(void);
+void netdev_list_rlock(void);
+void netdev_list_unlock(void);
+void netdev_list_runlock(void);
+
 /****************************************************************************
  * Name: netdev_verify
  *
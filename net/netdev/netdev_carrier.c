@@ -90,6 +90,10 @@ void netdev_carrier_off(FAR struct net_driver_s *dev)
       /* Clean up fragment data for this NIC (if any) */
 
       ip_frag_stop(dev);
+#elif defined(CONFIG_NET_TCP_TSO)
+      /* Drop the unsent TCP segments of this NIC */
+
+      iob_free_queue(&dev->d_fragout);
 #endif
 
       /* Notify clients that the network has been taken down */
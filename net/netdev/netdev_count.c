@@ -57,8 +57,8 @@ int netdev_count(void)
   struct net_driver_s *dev;
   int ndev;
 
-  net_lock();
+  netdev_list_rlock();
   for (dev = g_netdevices, ndev = 0; dev; dev = dev->flink, ndev++);
-  net_unlock();
+  netdev_list_runlock();
   return ndev;
 }
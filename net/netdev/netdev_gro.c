@@ -0,0 +1,313 @@
+/****************************************************************************
+ * net/netdev/netdev_gro.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "utils/utils.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NETDEV_GRO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define GRO_IPv4BUF(iob)  ((FAR struct ipv4_hdr_s *)IOB_DATA(iob))
+#define GRO_TCPBUF(iob)   ((FAR struct tcp_hdr_s *) \
+                           (IOB_DATA(iob) + IPv4_HDRLEN))
+#define GRO_TCPHDRLEN(t)  (((t)->tcpoffset >> 4) << 2)
+
+/* Segments with any of these flags are never coalesced */
+
+#define GRO_TCP_NOMERGE   (TCP_SYN | TCP_FIN | TCP_RST | TCP_URG)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_gro_payload
+ *
+ * Description:
+ *   Check whether the frame in d_iob is a TCP data segment addressed to
+ *   this device that may be coalesced:  An Ethernet frame holding an
+ *   unfragmented IPv4 packet without IP options, carrying a TCP segment
+ *   with data and no control flag other than ACK and PSH.  The checksums
+ *   of the frame are verified here.
+ *
+ * Returned Value:
+ *   The size of the TCP data, or 0 if the frame may not be coalesced.
+ *
+ ****************************************************************************/
+
+static unsigned int netdev_gro_payload(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct eth_hdr_s *eth = NETLLBUF;
+  FAR struct ipv4_hdr_s *ipv4 = GRO_IPv4BUF(iob);
+  FAR struct tcp_hdr_s *tcp = GRO_TCPBUF(iob);
+  unsigned int tcpiplen;
+  unsigned int totlen;
+
+  if (dev->d_lltype != NET_LL_ETHERNET || IFF_IS_NAT(dev->d_flags) ||
+      eth->type != HTONS(ETHTYPE_IP) || iob->io_len < IPv4TCP_HDRLEN ||
+      ipv4->vhl != 0x45 || ipv4->proto != IP_PROTO_TCP ||
+      (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+      !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                        dev->d_ipaddr))
+    {
+      return 0;
+    }
+
+  /* Padded frames are left to the normal input path */
+
+  totlen   = (ipv4->len[0] << 8) + ipv4->len[1];
+  tcpiplen = IPv4_HDRLEN + GRO_TCPHDRLEN(tcp);
+  if (totlen != iob->io_pktlen || tcpiplen < IPv4TCP_HDRLEN ||
+      tcpiplen >= totlen || tcpiplen > iob->io_len ||
+      (tcp->flags & (GRO_TCP_NOMERGE | TCP_ACK)) != TCP_ACK)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+  if (ipv4_chksum(ipv4) != 0xffff)
+    {
+      return 0;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  if (tcp_ipv4_chksum(dev) != 0xffff)
+    {
+      return 0;
+    }
+#endif
+
+  return totlen - tcpiplen;
+}
+
+/****************************************************************************
+ * Name: netdev_gro_follows
+ *
+ * Description:
+ *   Check whether the segment 'iob', with 'len' bytes of data, is the
+ *   continuation of the held segments of the same flow.
+ *
+ ****************************************************************************/
+
+static bool netdev_gro_follows(FAR struct net_driver_s *dev,
+                               FAR struct iob_s *iob, unsigned int len)
+{
+  FAR struct iob_s *held = dev->d_gro;
+  FAR struct ipv4_hdr_s *hipv4 = GRO_IPv4BUF(held);
+  FAR struct tcp_hdr_s *htcp = GRO_TCPBUF(held);
+  FAR struct ipv4_hdr_s *ipv4 = GRO_IPv4BUF(iob);
+  FAR struct tcp_hdr_s *tcp = GRO_TCPBUF(iob);
+  unsigned int tcphdrlen = GRO_TCPHDRLEN(tcp);
+  uint32_t hseq;
+
+  if (dev->d_grosegs >= CONFIG_NETDEV_GRO_MAXSEGS ||
+      held->io_pktlen + len > UINT16_MAX - NET_LL_HDRLEN(dev) ||
+      tcp->srcport != htcp->srcport || tcp->destport != htcp->destport ||
+      !net_ipv4addr_hdrcmp(ipv4->srcipaddr, hipv4->srcipaddr) ||
+      tcp->tcpoffset != htcp->tcpoffset ||
+      memcmp(tcp->optdata, htcp->optdata, tcphdrlen - TCP_HDRLEN) != 0)
+    {
+      return false;
+    }
+
+  hseq = tcp_getsequence(htcp->seqno) +
+         (held->io_pktlen - IPv4_HDRLEN - tcphdrlen);
+  return tcp_getsequence(tcp->seqno) == hseq;
+}
+
+/****************************************************************************
+ * Name: netdev_gro_merge
+ *
+ * Description:
+ *   Append the data of the segment 'iob' to the held segments.  The
+ *   coalesced segment carries the acknowledgement and the window of the
+ *   last segment.
+ *
+ ****************************************************************************/
+
+static void netdev_gro_merge(FAR struct net_driver_s *dev,
+                             FAR struct iob_s *iob)
+{
+  FAR struct iob_s *held = dev->d_gro;
+  FAR struct ipv4_hdr_s *hipv4 = GRO_IPv4BUF(held);
+  FAR struct tcp_hdr_s *htcp = GRO_TCPBUF(held);
+  FAR struct tcp_hdr_s *tcp = GRO_TCPBUF(iob);
+  unsigned int totlen;
+
+  memcpy(htcp->ackno, tcp->ackno, sizeof(htcp->ackno));
+  memcpy(htcp->wnd, tcp->wnd, sizeof(htcp->wnd));
+  htcp->flags |= tcp->flags & TCP_PSH;
+
+  iob = iob_trimhead(iob, IPv4_HDRLEN + GRO_TCPHDRLEN(tcp));
+  iob_concat(held, iob);
+
+  totlen = held->io_pktlen;
+  hipv4->len[0] = totlen >> 8;
+  hipv4->len[1] = totlen & 0xff;
+  dev->d_grosegs++;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_gro_receive
+ *
+ * Description:
+ *   Offer the frame in d_iob to the receive coalescing logic.  In-order
+ *   TCP data segments of the same IPv4 flow are chained behind the first
+ *   one and passed up the stack as a single segment.
+ *
+ * Input Parameters:
+ *   dev   - The network device that received the frame
+ *   input - The function that passes a frame in d_iob up the stack
+ *
+ * Returned Value:
+ *   true if the frame was taken; d_iob is then cleared.  false if the
+ *   frame must be passed up the stack by the caller.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+bool netdev_gro_receive(FAR struct net_driver_s *dev,
+                        netdev_gro_input_t input)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  unsigned int len;
+
+  len = netdev_gro_payload(dev);
+  if (len == 0)
+    {
+      /* Keep the order of the frames:  Anything held goes first */
+
+      if (dev->d_gro != NULL)
+        {
+          netdev_iob_clear(dev);
+          netdev_gro_flush(dev, input);
+          netdev_iob_release(dev);
+
+          dev->d_iob = iob;
+          dev->d_len = iob->io_pktlen + NET_LL_HDRLEN(dev);
+        }
+
+      return false;
+    }
+
+  netdev_iob_clear(dev);
+
+  if (dev->d_gro != NULL && netdev_gro_follows(dev, iob, len))
+    {
+      netdev_gro_merge(dev, iob);
+    }
+  else
+    {
+      netdev_gro_flush(dev, input);
+
+      dev->d_gro     = iob;
+      dev->d_grosegs = 1;
+    }
+
+  /* A pushed segment ends the coalescing of the flow */
+
+  if ((GRO_TCPBUF(dev->d_gro)->flags & TCP_PSH) != 0)
+    {
+      netdev_gro_flush(dev, input);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: netdev_gro_flush
+ *
+ * Description:
+ *   Pass the segments held by netdev_gro_receive() up the stack.
+ *
+ * Input Parameters:
+ *   dev   - The network device
+ *   input - The function that passes a frame in d_iob up the stack
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+void netdev_gro_flush(FAR struct net_driver_s *dev,
+                      netdev_gro_input_t input)
+{
+  FAR struct iob_s *iob = dev->d_gro;
+  FAR struct ipv4_hdr_s *ipv4;
+
+  if (iob == NULL)
+    {
+      return;
+    }
+
+  dev->d_gro = NULL;
+
+  if (dev->d_grosegs > 1)
+    {
+      ipv4 = GRO_IPv4BUF(iob);
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+    }
+
+  /* The TCP checksum of each segment was verified on reception, the
+   * coalesced segment has none.
+   */
+
+  netdev_iob_release(dev);
+  dev->d_iob       = iob;
+  dev->d_len       = iob->io_pktlen + NET_LL_HDRLEN(dev);
+  dev->d_grochksum = true;
+
+  input(dev);
+
+  dev->d_grochksum = false;
+}
+
+#endif /* CONFIG_NETDEV_GRO */
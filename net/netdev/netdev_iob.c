@@ -29,6 +29,7 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/lib/math32.h>
 #include <nuttx/net/netdev.h>
 
 /****************************************************************************
@@ -210,7 +211,14 @@ FAR struct iob_s *netdev_iob_clone(FAR struct net_driver_s *dev,
   FAR struct iob_s *iob;
   int ret;
 
-  iob = iob_tryalloc(throttled);
+  /* Allocate the whole destination chain with one acquisition of the IOB
+   * lock instead of one buffer at a time while cloning.
+   */
+
+  iob = iob_tryalloc_chain(throttled,
+                           div_round_up(CONFIG_NET_LL_GUARDSIZE +
+                                        dev->d_iob->io_pktlen,
+                                        CONFIG_IOB_BUFSIZE));
   if (iob == NULL)
     {
       nwarn("WARNING: IOB alloc failed for dev %s!\n", dev->d_ifname);
@@ -35,6 +35,7 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/rwsem.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
@@ -87,6 +88,10 @@
 
 struct net_driver_s *g_netdevices = NULL;
 
+/* Read-mostly protection of g_netdevices and of the interface indices */
+
+static rw_semaphore_t g_netdev_lock = RWSEM_INITIALIZER;
+
 #ifdef CONFIG_NETDEV_IFINDEX
 /* The set of network devices that have been registered.  This is used to
  * assign a unique device index to the newly registered device.
@@ -216,6 +221,68 @@ static int get_ifindex(void)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_list_lock
+ *
+ * Description:
+ *   Get exclusive access to the list of network devices, in order to
+ *   modify it.  The caller must also hold the network lock, so that the
+ *   list may be traversed while holding either lock.
+ *
+ ****************************************************************************/
+
+void netdev_list_lock(void)
+{
+  down_write(&g_netdev_lock);
+}
+
+/****************************************************************************
+ * Name: netdev_list_rlock
+ *
+ * Description:
+ *   Get shared access to the list of network devices, in order to traverse
+ *   it without holding the network lock.  Nothing is taken if the caller
+ *   holds the network lock, which already excludes the writers.
+ *
+ ****************************************************************************/
+
+void netdev_list_rlock(void)
+{
+  if (!net_lock_held())
+    {
+      down_read(&g_netdev_lock);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_list_unlock
+ *
+ * Description:
+ *   Relinquish exclusive access to the list of network devices.
+ *
+ ****************************************************************************/
+
+void netdev_list_unlock(void)
+{
+  up_write(&g_netdev_lock);
+}
+
+/****************************************************************************
+ * Name: netdev_list_runlock
+ *
+ * Description:
+ *   Relinquish shared access to the list of network devices.
+ *
+ ****************************************************************************/
+
+void netdev_list_runlock(void)
+{
+  if (!net_lock_held())
+    {
+      up_read(&g_netdev_lock);
+    }
+}
+
 /****************************************************************************
  * Name: netdev_register
  *
@@ -391,15 +458,21 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       dev->d_conncb = NULL;
       dev->d_conncb_tail = NULL;
       dev->d_devcb = NULL;
+#ifdef CONFIG_NETDEV_TXREADY
+      dq_init(&dev->d_tcpready);
+      dq_init(&dev->d_udpready);
+#endif
 
       /* We need exclusive access for the following operations */
 
       net_lock();
+      netdev_list_lock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
       ifindex = get_ifindex();
       if (ifindex < 0)
         {
+          netdev_list_unlock();
           net_unlock();
           return ifindex;
         }
@@ -484,6 +557,7 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       icmpv6_devinit(dev);
 #endif
 
+      netdev_list_unlock();
       net_unlock();
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_DRIVERS_IEEE80211)
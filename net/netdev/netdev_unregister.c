@@ -35,9 +35,12 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
+#include "tcp/tcp.h"
+#include "udp/udp.h"
 #include "netdev/netdev.h"
 
 /****************************************************************************
@@ -118,6 +121,7 @@ int netdev_unregister(FAR struct net_driver_s *dev)
   if (dev)
     {
       net_lock();
+      netdev_list_lock();
 
       /* Find the device in the list of known network devices */
 
@@ -150,6 +154,28 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
+
+#ifdef CONFIG_NETDEV_TXREADY
+      /* Forget the connections waiting to send through the device */
+
+#  ifdef NET_TCP_HAVE_STACK
+      while (!dq_empty(&dev->d_tcpready))
+        {
+          tcp_txready_remove(container_of(dev->d_tcpready.head,
+                                          struct tcp_conn_s, txready_node));
+        }
+#  endif
+
+#  ifdef NET_UDP_HAVE_STACK
+      while (!dq_empty(&dev->d_udpready))
+        {
+          udp_txready_remove(container_of(dev->d_udpready.head,
+                                          struct udp_conn_s, txready_node));
+        }
+#  endif
+#endif
+
+      netdev_list_unlock();
       net_unlock();
 
 #if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
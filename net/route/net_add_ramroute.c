@@ -83,11 +83,17 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   /* Get exclusive address to the networking data structures */
 
   net_lock();
+  net_lock_ramroute();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+#ifdef CONFIG_ROUTE_LPM
+  ramroute_ipv4_lpmadd((FAR struct net_route_ipv4_entry_s *)route);
+#endif
+
+  net_unlock_ramroute();
   net_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
@@ -120,11 +126,17 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   /* Get exclusive address to the networking data structures */
 
   net_lock();
+  net_lock_ramroute();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+#ifdef CONFIG_ROUTE_LPM
+  ramroute_ipv6_lpmadd((FAR struct net_route_ipv6_entry_s *)route);
+#endif
+
+  net_unlock_ramroute();
   net_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET6);
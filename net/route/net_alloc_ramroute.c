@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <assert.h>
 
+#include <nuttx/rwsem.h>
 #include <nuttx/net/net.h>
 #include <arch/irq.h>
 
@@ -58,6 +59,10 @@ FAR struct net_route_ipv6_queue_s g_ipv6_routes;
  * Private Data
  ****************************************************************************/
 
+/* Read-mostly protection of the routing tables and of the free lists */
+
+static rw_semaphore_t g_ramroute_lock = RWSEM_INITIALIZER;
+
 /* These are lists of free routing table entries */
 
 #ifdef CONFIG_ROUTE_IPv4_RAMROUTE
@@ -84,6 +89,43 @@ static struct net_route_ipv6_entry_s
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_lock_ramroute, net_rlock_ramroute, net_unlock_ramroute and
+ *       net_runlock_ramroute
+ *
+ * Description:
+ *   Get and relinquish exclusive (write) or shared (read) access to the
+ *   in-memory routing tables.  A reader that holds the network lock
+ *   already excludes the writers, so the read lock is skipped then.
+ *
+ ****************************************************************************/
+
+void net_lock_ramroute(void)
+{
+  down_write(&g_ramroute_lock);
+}
+
+void net_rlock_ramroute(void)
+{
+  if (!net_lock_held())
+    {
+      down_read(&g_ramroute_lock);
+    }
+}
+
+void net_unlock_ramroute(void)
+{
+  up_write(&g_ramroute_lock);
+}
+
+void net_runlock_ramroute(void)
+{
+  if (!net_lock_held())
+    {
+      up_read(&g_ramroute_lock);
+    }
+}
+
 /****************************************************************************
  * Name: net_init_ramroute
  *
@@ -130,6 +172,10 @@ void net_init_ramroute(void)
       ramroute_ipv6_addlast(&g_prealloc_ipv6routes[i], &g_free_ipv6routes);
     }
 #endif
+
+#ifdef CONFIG_ROUTE_LPM
+  net_init_lpmroute();
+#endif
 }
 
 /****************************************************************************
@@ -152,15 +198,15 @@ FAR struct net_route_ipv4_s *net_allocroute_ipv4(void)
 {
   FAR struct net_route_ipv4_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the free list */
 
-  net_lock();
+  net_lock_ramroute();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv4_remfirst(&g_free_ipv4routes);
 
-  net_unlock();
+  net_unlock_ramroute();
   if (!route)
     {
       return NULL;
@@ -175,15 +221,15 @@ FAR struct net_route_ipv6_s *net_allocroute_ipv6(void)
 {
   FAR struct net_route_ipv6_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the free list */
 
-  net_lock();
+  net_lock_ramroute();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv6_remfirst(&g_free_ipv6routes);
 
-  net_unlock();
+  net_unlock_ramroute();
   if (!route)
     {
       return NULL;
@@ -212,15 +258,15 @@ void net_freeroute_ipv4(FAR struct net_route_ipv4_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the free list */
 
-  net_lock();
+  net_lock_ramroute();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_free_ipv4routes);
-  net_unlock();
+  net_unlock_ramroute();
 }
 #endif
 
@@ -229,15 +275,15 @@ void net_freeroute_ipv6(FAR struct net_route_ipv6_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the free list */
 
-  net_lock();
+  net_lock_ramroute();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_free_ipv6routes);
-  net_unlock();
+  net_unlock_ramroute();
 }
 #endif
 
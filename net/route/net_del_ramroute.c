@@ -113,6 +113,10 @@ static int net_del_ipv4route(FAR struct net_route_ipv4_s *route,
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM
+      ramroute_ipv4_lpmdel((FAR struct net_route_ipv4_entry_s *)route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET);
 
       /* And free the routing table entry by adding it to the free list */
@@ -171,6 +175,10 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM
+      ramroute_ipv6_lpmdel((FAR struct net_route_ipv6_entry_s *)route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET6);
 
       /* And free the routing table entry by adding it to the free list */
@@ -210,6 +218,7 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -217,9 +226,17 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_ipv4addr_copy(match.target, target);
   net_ipv4addr_copy(match.netmask, netmask);
 
-  /* Then remove the entry from the routing table */
+  /* Then remove the entry from the routing table.  The traversal holds
+   * the write lock, so that the handler may modify the table.
+   */
+
+  net_lock();
+  net_lock_ramroute();
+  ret = net_foreachroute_ipv4(net_del_ipv4route, &match);
+  net_unlock_ramroute();
+  net_unlock();
 
-  return net_foreachroute_ipv4(net_del_ipv4route, &match) ? OK : -ENOENT;
+  return ret ? OK : -ENOENT;
 }
 #endif
 
@@ -227,6 +244,7 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -234,9 +252,17 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_ipv6addr_copy(match.target, target);
   net_ipv6addr_copy(match.netmask, netmask);
 
-  /* Then remove the entry from the routing table */
+  /* Then remove the entry from the routing table.  The traversal holds
+   * the write lock, so that the handler may modify the table.
+   */
+
+  net_lock();
+  net_lock_ramroute();
+  ret = net_foreachroute_ipv6(net_del_ipv6route, &match);
+  net_unlock_ramroute();
+  net_unlock();
 
-  return net_foreachroute_ipv6(net_del_ipv6route, &match) ? OK : -ENOENT;
+  return ret ? OK : -ENOENT;
 }
 #endif
 
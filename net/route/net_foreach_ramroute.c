@@ -57,6 +57,10 @@
  *   value will be returned in the event of a failure.  Handlers may also
  *   terminate the search early with any non-zero, non-negative value.
  *
+ * Assumptions:
+ *   The handler may only modify the table if the caller holds the write
+ *   lock, and may only take the network lock if the caller holds it.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_ROUTE_IPv4_RAMROUTE
@@ -66,9 +70,9 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
   FAR struct net_route_ipv4_entry_s *next;
   int ret = 0;
 
-  /* Prevent concurrent access to the routing table */
+  /* Prevent concurrent modifications of the routing table */
 
-  net_lock();
+  net_rlock_ramroute();
 
   /* Visit each entry in the routing table */
 
@@ -82,9 +86,9 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_runlock_ramroute();
   return ret;
 }
 #endif
@@ -96,9 +100,9 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
   FAR struct net_route_ipv6_entry_s *next;
   int ret = 0;
 
-  /* Prevent concurrent access to the routing table */
+  /* Prevent concurrent modifications of the routing table */
 
-  net_lock();
+  net_rlock_ramroute();
 
   /* Visit each entry in the routing table */
 
@@ -112,9 +116,9 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_runlock_ramroute();
   return ret;
 }
 #endif
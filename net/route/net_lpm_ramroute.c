@@ -0,0 +1,622 @@
+/****************************************************************************
+ * net/route/net_lpm_ramroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#  define LPM_KEYSIZE     16
+#else
+#  define LPM_KEYSIZE     4
+#endif
+
+/* Bit 'i' of a key, counting from the MS bit of the first byte */
+
+#define LPM_BIT(k, i)     (((k)[(i) >> 3] >> (7 - ((i) & 7))) & 1)
+
+/* A Patricia trie of n prefixes has at most n - 1 branching nodes */
+
+#define LPM_NNODES(n)     (2 * (n))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of the trie.  The prefix of a node extends the prefix of its
+ * parent, child[b] holds the prefixes whose next bit is b.  A node without
+ * routes only exists to branch, it always has two children.
+ */
+
+struct route_lpm_node_s
+{
+  FAR struct route_lpm_node_s *parent;
+  FAR struct route_lpm_node_s *child[2];
+  sq_queue_t routes;              /* Routes of this prefix, in table order */
+  uint8_t prefix[LPM_KEYSIZE];    /* Prefix, with the bits past plen clear */
+  uint8_t plen;                   /* Prefix length in bits */
+};
+
+/* The trie indexing one routing table */
+
+struct route_lpm_s
+{
+  FAR struct route_lpm_node_s *root;
+  FAR struct route_lpm_node_s *free;  /* Free nodes, linked by child[0] */
+  uint16_t nsparse;                   /* Routes with non-contiguous masks */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static struct route_lpm_s g_ipv4_lpm;
+static struct route_lpm_node_s
+  g_ipv4_lpmnodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv4_RAMROUTES)];
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static struct route_lpm_s g_ipv6_lpm;
+static struct route_lpm_node_s
+  g_ipv6_lpmnodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv6_RAMROUTES)];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_lpm_init
+ *
+ * Description:
+ *   Empty a trie and put all of its nodes in the free list.
+ *
+ ****************************************************************************/
+
+static void route_lpm_init(FAR struct route_lpm_s *lpm,
+                           FAR struct route_lpm_node_s *nodes, int nnodes)
+{
+  int i;
+
+  lpm->root    = NULL;
+  lpm->free    = NULL;
+  lpm->nsparse = 0;
+
+  for (i = 0; i < nnodes; i++)
+    {
+      nodes[i].child[0] = lpm->free;
+      lpm->free         = &nodes[i];
+    }
+}
+
+/****************************************************************************
+ * Name: route_lpm_prefixlen
+ *
+ * Description:
+ *   Return the prefix length of a network mask of 'size' bytes, or -1 if
+ *   the mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int route_lpm_prefixlen(FAR const uint8_t *mask, unsigned int size)
+{
+  unsigned int i = 0;
+  int plen = 0;
+  uint8_t byte;
+
+  while (i < size && mask[i] == 0xff)
+    {
+      plen += 8;
+      i++;
+    }
+
+  if (i < size)
+    {
+      for (byte = mask[i++]; (byte & 0x80) != 0; byte <<= 1)
+        {
+          plen++;
+        }
+
+      if (byte != 0)
+        {
+          return -1;
+        }
+
+      while (i < size)
+        {
+          if (mask[i++] != 0)
+            {
+              return -1;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: route_lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits that two keys have in common, at
+ *   most 'maxbits'.
+ *
+ ****************************************************************************/
+
+static unsigned int route_lpm_common(FAR const uint8_t *a,
+                                     FAR const uint8_t *b,
+                                     unsigned int maxbits)
+{
+  unsigned int bits = 0;
+  uint8_t diff;
+
+  while (bits < maxbits)
+    {
+      diff = a[bits >> 3] ^ b[bits >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              bits++;
+            }
+
+          break;
+        }
+
+      bits += 8;
+    }
+
+  return MIN(bits, maxbits);
+}
+
+/****************************************************************************
+ * Name: route_lpm_alloc
+ *
+ * Description:
+ *   Take a node from the free list and set its prefix to the first 'plen'
+ *   bits of 'key'.
+ *
+ ****************************************************************************/
+
+static FAR struct route_lpm_node_s *
+route_lpm_alloc(FAR struct route_lpm_s *lpm, FAR const uint8_t *key,
+                unsigned int plen)
+{
+  FAR struct route_lpm_node_s *node = lpm->free;
+  unsigned int nbytes = (plen + 7) >> 3;
+
+  /* The free list is sized for the worst case */
+
+  DEBUGASSERT(node != NULL);
+  lpm->free = node->child[0];
+
+  memset(node, 0, sizeof(struct route_lpm_node_s));
+  memcpy(node->prefix, key, nbytes);
+  if ((plen & 7) != 0)
+    {
+      node->prefix[nbytes - 1] &= 0xff << (8 - (plen & 7));
+    }
+
+  node->plen = plen;
+  return node;
+}
+
+/****************************************************************************
+ * Name: route_lpm_link
+ *
+ * Description:
+ *   Put 'node', which may be NULL, in the place of 'old' in the trie, 'old'
+ *   being a child of 'parent' or the root if 'parent' is NULL.
+ *
+ ****************************************************************************/
+
+static void route_lpm_link(FAR struct route_lpm_s *lpm,
+                           FAR struct route_lpm_node_s *parent,
+                           FAR struct route_lpm_node_s *old,
+                           FAR struct route_lpm_node_s *node)
+{
+  if (parent == NULL)
+    {
+      lpm->root = node;
+    }
+  else
+    {
+      parent->child[parent->child[1] == old] = node;
+    }
+
+  if (node != NULL)
+    {
+      node->parent = parent;
+    }
+}
+
+/****************************************************************************
+ * Name: route_lpm_insert
+ *
+ * Description:
+ *   Return the node of the prefix made of the first 'plen' bits of 'key',
+ *   adding it to the trie if needed.
+ *
+ ****************************************************************************/
+
+static FAR struct route_lpm_node_s *
+route_lpm_insert(FAR struct route_lpm_s *lpm, FAR const uint8_t *key,
+                 unsigned int plen)
+{
+  FAR struct route_lpm_node_s **slot = &lpm->root;
+  FAR struct route_lpm_node_s *parent = NULL;
+  FAR struct route_lpm_node_s *node;
+  FAR struct route_lpm_node_s *leaf;
+  FAR struct route_lpm_node_s *top;
+  unsigned int common = 0;
+
+  /* Descend while the prefix of the node is a prefix of the new one */
+
+  while ((node = *slot) != NULL)
+    {
+      common = route_lpm_common(node->prefix, key, MIN(node->plen, plen));
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          return node;
+        }
+
+      parent = node;
+      slot   = &node->child[LPM_BIT(key, node->plen)];
+    }
+
+  leaf = route_lpm_alloc(lpm, key, plen);
+  top  = leaf;
+
+  if (node != NULL && common == plen)
+    {
+      /* The new prefix is a prefix of the node, it goes above it */
+
+      leaf->child[LPM_BIT(node->prefix, plen)] = node;
+      node->parent = leaf;
+    }
+  else if (node != NULL)
+    {
+      /* The prefixes diverge, branch where they do */
+
+      top = route_lpm_alloc(lpm, key, common);
+      top->child[LPM_BIT(key, common)]          = leaf;
+      top->child[LPM_BIT(node->prefix, common)] = node;
+      leaf->parent = top;
+      node->parent = top;
+    }
+
+  top->parent = parent;
+  *slot       = top;
+  return leaf;
+}
+
+/****************************************************************************
+ * Name: route_lpm_remove
+ *
+ * Description:
+ *   Remove a node that has no route left, and its parent if that was only
+ *   there to branch to it.
+ *
+ ****************************************************************************/
+
+static void route_lpm_remove(FAR struct route_lpm_s *lpm,
+                             FAR struct route_lpm_node_s *node)
+{
+  FAR struct route_lpm_node_s *parent;
+  FAR struct route_lpm_node_s *child;
+
+  while (node != NULL && sq_empty(&node->routes) &&
+         (node->child[0] == NULL || node->child[1] == NULL))
+    {
+      parent = node->parent;
+      child  = node->child[node->child[0] == NULL];
+
+      route_lpm_link(lpm, parent, node, child);
+
+      node->child[0] = lpm->free;
+      lpm->free      = node;
+      node           = parent;
+    }
+}
+
+/****************************************************************************
+ * Name: route_lpm_match
+ *
+ * Description:
+ *   Return the node with routes of the longest prefix matching the 'nbits'
+ *   bits of 'key', or NULL.  The nodes with routes of the shorter matching
+ *   prefixes are its ancestors.
+ *
+ ****************************************************************************/
+
+static FAR struct route_lpm_node_s *
+route_lpm_match(FAR struct route_lpm_s *lpm, FAR const uint8_t *key,
+                unsigned int nbits)
+{
+  FAR struct route_lpm_node_s *node = lpm->root;
+  FAR struct route_lpm_node_s *best = NULL;
+
+  while (node != NULL &&
+         route_lpm_common(node->prefix, key, node->plen) == node->plen)
+    {
+      if (!sq_empty(&node->routes))
+        {
+          best = node;
+        }
+
+      if (node->plen >= nbits)
+        {
+          break;
+        }
+
+      node = node->child[LPM_BIT(key, node->plen)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: route_lpm_add
+ *
+ * Description:
+ *   Index a route, given its target and network mask of 'size' bytes.
+ *
+ ****************************************************************************/
+
+static void route_lpm_add(FAR struct route_lpm_s *lpm,
+                          FAR const void *target, FAR const void *netmask,
+                          unsigned int size, FAR sq_entry_t *link)
+{
+  FAR struct route_lpm_node_s *node;
+  int plen;
+
+  plen = route_lpm_prefixlen(netmask, size);
+  if (plen < 0)
+    {
+      /* Not a prefix, lookups fall back to the traversal of the table */
+
+      lpm->nsparse++;
+      return;
+    }
+
+  node = route_lpm_insert(lpm, target, plen);
+  sq_addlast(link, &node->routes);
+}
+
+/****************************************************************************
+ * Name: route_lpm_del
+ *
+ * Description:
+ *   Remove a route indexed by route_lpm_add().
+ *
+ ****************************************************************************/
+
+static void route_lpm_del(FAR struct route_lpm_s *lpm,
+                          FAR const void *target, FAR const void *netmask,
+                          unsigned int size, FAR sq_entry_t *link)
+{
+  FAR struct route_lpm_node_s *node;
+  int plen;
+
+  plen = route_lpm_prefixlen(netmask, size);
+  if (plen < 0)
+    {
+      DEBUGASSERT(lpm->nsparse > 0);
+      lpm->nsparse--;
+      return;
+    }
+
+  node = route_lpm_match(lpm, target, plen);
+  while (node != NULL && node->plen != plen)
+    {
+      node = node->parent;
+    }
+
+  DEBUGASSERT(node != NULL);
+  sq_rem(link, &node->routes);
+  route_lpm_remove(lpm, node);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index of the in-memory routing
+ *   tables.
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+  route_lpm_init(&g_ipv4_lpm, g_ipv4_lpmnodes, nitems(g_ipv4_lpmnodes));
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+  route_lpm_init(&g_ipv6_lpm, g_ipv6_lpmnodes, nitems(g_ipv6_lpmnodes));
+#endif
+}
+
+/****************************************************************************
+ * Name: ramroute_ipv4_lpmadd, ramroute_ipv4_lpmdel, ramroute_ipv6_lpmadd
+ *       and ramroute_ipv6_lpmdel
+ *
+ * Description:
+ *   Add a route to, or remove it from, the longest prefix match index
+ *   along with its insertion in, or its removal from, the routing table.
+ *
+ * Input Parameters:
+ *   entry - The routing table entry
+ *
+ * Assumptions:
+ *   The caller holds the network lock and the write lock of the tables.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void ramroute_ipv4_lpmadd(FAR struct net_route_ipv4_entry_s *entry)
+{
+  route_lpm_add(&g_ipv4_lpm, &entry->entry.target, &entry->entry.netmask,
+                sizeof(in_addr_t), &entry->lpmlink);
+}
+
+void ramroute_ipv4_lpmdel(FAR struct net_route_ipv4_entry_s *entry)
+{
+  route_lpm_del(&g_ipv4_lpm, &entry->entry.target, &entry->entry.netmask,
+                sizeof(in_addr_t), &entry->lpmlink);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void ramroute_ipv6_lpmadd(FAR struct net_route_ipv6_entry_s *entry)
+{
+  route_lpm_add(&g_ipv6_lpm, entry->entry.target, entry->entry.netmask,
+                sizeof(net_ipv6addr_t), &entry->lpmlink);
+}
+
+void ramroute_ipv6_lpmdel(FAR struct net_route_ipv6_entry_s *entry)
+{
+  route_lpm_del(&g_ipv6_lpm, entry->entry.target, entry->entry.netmask,
+                sizeof(net_ipv6addr_t), &entry->lpmlink);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Visit the routes that match a target address, from the longest prefix
+ *   to the shortest, the routes of a same prefix in table order.
+ *
+ * Input Parameters:
+ *   target  - The target address
+ *   handler - Will be called for each matching route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) if all the matching routes were visited, or the non-zero,
+ *   non-negative value that terminated the search, as with
+ *   net_foreachroute_ipv4() and net_foreachroute_ipv6().  -ENOSYS if the
+ *   table holds routes with non-contiguous network masks; the caller must
+ *   then traverse the whole table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg)
+{
+  FAR struct route_lpm_node_s *node;
+  FAR sq_entry_t *link;
+  int ret = 0;
+
+  net_rlock_ramroute();
+
+  if (g_ipv4_lpm.nsparse > 0)
+    {
+      net_runlock_ramroute();
+      return -ENOSYS;
+    }
+
+  node = route_lpm_match(&g_ipv4_lpm, (FAR const uint8_t *)&target, 32);
+  for (; ret == 0 && node != NULL; node = node->parent)
+    {
+      for (link = sq_peek(&node->routes); ret == 0 && link != NULL;
+           link = sq_next(link))
+        {
+          ret = handler(&container_of(link, struct net_route_ipv4_entry_s,
+                                      lpmlink)->entry, arg);
+        }
+    }
+
+  net_runlock_ramroute();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct route_lpm_node_s *node;
+  FAR sq_entry_t *link;
+  int ret = 0;
+
+  net_rlock_ramroute();
+
+  if (g_ipv6_lpm.nsparse > 0)
+    {
+      net_runlock_ramroute();
+      return -ENOSYS;
+    }
+
+  node = route_lpm_match(&g_ipv6_lpm, (FAR const uint8_t *)target, 128);
+  for (; ret == 0 && node != NULL; node = node->parent)
+    {
+      for (link = sq_peek(&node->routes); ret == 0 && link != NULL;
+           link = sq_next(link))
+        {
+          ret = handler(&container_of(link, struct net_route_ipv6_entry_s,
+                                      lpmlink)->entry, arg);
+        }
+    }
+
+  net_runlock_ramroute();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
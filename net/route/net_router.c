@@ -36,6 +36,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/ramroute.h"
 #include "route/route.h"
 #include "utils/utils.h"
 
@@ -283,7 +284,15 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+      /* Only visit the routes whose prefix matches, longest first */
+
+      ret = net_lpmroute_ipv4(target, net_ipv4_match, &match);
+      if (ret < 0)
+#endif
+        {
+          ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+        }
     }
 
   /* Did we find a route? */
@@ -377,7 +386,15 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+      /* Only visit the routes whose prefix matches, longest first */
+
+      ret = net_lpmroute_ipv6(target, net_ipv6_match, &match);
+      if (ret < 0)
+#endif
+        {
+          ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+        }
     }
 
   /* Did we find a route? */
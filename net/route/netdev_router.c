@@ -35,6 +35,7 @@
 
 #include "netdev/netdev.h"
 #include "route/cacheroute.h"
+#include "route/ramroute.h"
 #include "route/route.h"
 #include "utils/utils.h"
 
@@ -284,7 +285,15 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_devmatch, &match);
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+      /* Only visit the routes whose prefix matches, longest first */
+
+      ret = net_lpmroute_ipv4(target, net_ipv4_devmatch, &match);
+      if (ret < 0)
+#endif
+        {
+          ret = net_foreachroute_ipv4(net_ipv4_devmatch, &match);
+        }
     }
 
   /* Did we find a route? */
@@ -371,7 +380,15 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_devmatch, &match);
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+      /* Only visit the routes whose prefix matches, longest first */
+
+      ret = net_lpmroute_ipv6(target, net_ipv6_devmatch, &match);
+      if (ret < 0)
+#endif
+        {
+          ret = net_foreachroute_ipv6(net_ipv6_devmatch, &match);
+        }
     }
 
   /* Did we find a route? */
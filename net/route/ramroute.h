@@ -29,6 +29,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/queue.h>
+
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -68,6 +70,9 @@ struct net_route_ipv4_entry_s
 {
   struct net_route_ipv4_s entry;
   FAR struct net_route_ipv4_entry_s *flink;
+#ifdef CONFIG_ROUTE_LPM
+  sq_entry_t lpmlink;               /* Link in the node of its prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -86,6 +91,9 @@ struct net_route_ipv6_entry_s
 {
   struct net_route_ipv6_s entry;
   FAR struct net_route_ipv6_entry_s *flink;
+#ifdef CONFIG_ROUTE_LPM
+  sq_entry_t lpmlink;               /* Link in the node of its prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -119,6 +127,27 @@ extern struct net_route_ipv6_queue_s g_ipv6_routes;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_lock_ramroute, net_rlock_ramroute, net_unlock_ramroute and
+ *       net_runlock_ramroute
+ *
+ * Description:
+ *   Read-mostly protection of the in-memory routing tables.  The tables
+ *   are only modified with both the network lock and the write lock held,
+ *   so that lookups may traverse them holding either the network lock or
+ *   the read lock.  The network lock is always taken first.
+ *
+ *   net_rlock_ramroute() takes nothing if the caller holds the network
+ *   lock, so a reader must not take or release the network lock before
+ *   net_runlock_ramroute().
+ *
+ ****************************************************************************/
+
+void net_lock_ramroute(void);
+void net_rlock_ramroute(void);
+void net_unlock_ramroute(void);
+void net_runlock_ramroute(void);
+
 /****************************************************************************
  * Name: net_init_ramroute
  *
@@ -218,5 +247,77 @@ ramroute_ipv6_remafter(FAR struct net_route_ipv6_entry_s *entry,
                        FAR struct net_route_ipv6_queue_s *list);
 #endif
 
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index of the in-memory routing
+ *   tables.
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_LPM
+void net_init_lpmroute(void);
+#endif
+
+/****************************************************************************
+ * Name: ramroute_ipv4_lpmadd, ramroute_ipv4_lpmdel, ramroute_ipv6_lpmadd
+ *       and ramroute_ipv6_lpmdel
+ *
+ * Description:
+ *   Add a route to, or remove it from, the longest prefix match index
+ *   along with its insertion in, or its removal from, the routing table.
+ *
+ * Input Parameters:
+ *   entry - The routing table entry
+ *
+ * Assumptions:
+ *   The caller holds the network lock and the write lock of the tables.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+void ramroute_ipv4_lpmadd(FAR struct net_route_ipv4_entry_s *entry);
+void ramroute_ipv4_lpmdel(FAR struct net_route_ipv4_entry_s *entry);
+#endif
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+void ramroute_ipv6_lpmadd(FAR struct net_route_ipv6_entry_s *entry);
+void ramroute_ipv6_lpmdel(FAR struct net_route_ipv6_entry_s *entry);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Visit the routes that match a target address, from the longest prefix
+ *   to the shortest, the routes of a same prefix in table order.
+ *
+ * Input Parameters:
+ *   target  - The target address
+ *   handler - Will be called for each matching route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) if all the matching routes were visited, or the non-zero,
+ *   non-negative value that terminated the search.  -ENOSYS if the table
+ *   holds routes with non-contiguous network masks; the caller must then
+ *   traverse the whole table.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg);
+#endif
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg);
+#endif
+
 #endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
 #endif /* __NET_ROUTE_RAMROUTE_H */
@@ -291,6 +291,23 @@ struct tcp_conn_s
 
   FAR struct net_driver_s *dev;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  /* Links in the lookup tables:  hash_node chains the active connections
+   * with the same hash of the remote address and ports, listen_node the
+   * listeners with the same hash of the local port.
+   */
+
+  dq_entry_t hash_node;
+  dq_entry_t listen_node;
+#endif
+
+#ifdef CONFIG_NETDEV_TXREADY
+  /* Entry in the d_tcpready queue of txready_dev, if not NULL */
+
+  dq_entry_t txready_node;
+  FAR struct net_driver_s *txready_dev;
+#endif
+
   /* Read-ahead buffering.
    *
    *   readahead - An IOB chain where the TCP/IP read-ahead data is retained.
@@ -939,6 +956,68 @@ void tcp_nextsequence(void);
 
 void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_txready
+ *
+ * Description:
+ *   Queue a TCP connection with pending TX work on the TX ready queue of
+ *   its device, so that the next devif_poll() of the device polls it.  The
+ *   caller still notifies the device driver.
+ *
+ * Input Parameters:
+ *   conn - The TCP "connection" with TX work
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void tcp_txready(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_txready(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_txready_remove
+ *
+ * Description:
+ *   Remove a TCP connection from the TX ready queue of its device, if it
+ *   is queued.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void tcp_txready_remove(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_tso_segment
+ *
+ * Description:
+ *   Cut the large TCP packet in d_iob into segments of d_gsosize bytes of
+ *   data and queue them in d_fragout, from where they are sent like IP
+ *   fragments.
+ *
+ * Input Parameters:
+ *   dev - The network device holding the packet in d_iob
+ *
+ * Returned Value:
+ *   OK on success, d_iob is then released.  A negated errno value if no
+ *   segment could be queued.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TSO
+int tcp_tso_segment(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: tcp_timer
  *
@@ -1847,6 +1926,22 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void);
 void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_wrbuffer_release_queue
+ *
+ * Description:
+ *   Release all of the TCP write buffers in a queue, returning their I/O
+ *   buffers with one acquisition of the IOB lock.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+void tcp_wrbuffer_release_queue(FAR sq_queue_t *queue);
+#endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
+
 /****************************************************************************
  * Name: tcp_wrbuffer_inqueue_size
  *
@@ -211,10 +211,12 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   else
     {
       /* The application cannot send more than what is allowed by the
-       * MSS (the minimum of the MSS and the available window).
+       * MSS (the minimum of the MSS and the available window), unless it
+       * is a large send that is cut into MSS sized segments.
        */
 
-      DEBUGASSERT(dev->d_sndlen <= conn->mss);
+      DEBUGASSERT(dev->d_sndlen <= conn->mss ||
+                  NETDEV_GSOSIZE(dev) == conn->mss);
 
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || defined(CONFIG_NET_SENDFILE)
 
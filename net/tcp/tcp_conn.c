@@ -58,6 +58,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -81,6 +82,15 @@
 #  define CONFIG_NET_TCP_MAX_CONNS 0
 #endif
 
+/* Get the connection from an entry of the list being searched */
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_CONN_HASHMASK   (CONFIG_NET_TCP_CONN_HASHSIZE - 1)
+#  define tcp_entry2conn(e)   container_of(e, struct tcp_conn_s, hash_node)
+#else
+#  define tcp_entry2conn(e)   ((FAR struct tcp_conn_s *)(e))
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -95,10 +105,99 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The active connections, hashed by remote address and ports */
+
+static dq_queue_t g_tcp_conn_hash[CONFIG_NET_TCP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash
+ *
+ * Description:
+ *   Return the index of the hash bucket for a connection with the remote
+ *   address 'raddr', folded to 32 bits, and the ports 'lport' and 'rport'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+static inline unsigned int tcp_hash(uint32_t raddr, uint16_t lport,
+                                    uint16_t rport)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16 | rport);
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash & TCP_CONN_HASHMASK;
+}
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *addr)
+{
+  return ((uint32_t)addr[0] << 16 | addr[1]) ^
+         ((uint32_t)addr[2] << 16 | addr[3]) ^
+         ((uint32_t)addr[4] << 16 | addr[5]) ^
+         ((uint32_t)addr[6] << 16 | addr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_bucket
+ *
+ * Description:
+ *   Return the hash bucket of an active connection.
+ *
+ ****************************************************************************/
+
+static FAR dq_queue_t *tcp_conn_bucket(FAR struct tcp_conn_s *conn)
+{
+  uint32_t raddr;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      raddr = tcp_ipv6_fold(conn->u.ipv6.raddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      raddr = conn->u.ipv4.raddr;
+    }
+#endif
+
+  return &g_tcp_conn_hash[tcp_hash(raddr, conn->lport, conn->rport)];
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+/****************************************************************************
+ * Name: tcp_addactive
+ *
+ * Description:
+ *   Add a connection whose addresses and ports are all set to the list of
+ *   active connections.
+ *
+ ****************************************************************************/
+
+static void tcp_addactive(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  dq_addlast(&conn->hash_node, tcp_conn_bucket(conn));
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -192,15 +291,24 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
-  while (conn)
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  entry = g_tcp_conn_hash[tcp_hash(srcipaddr, tcp->destport,
+                                   tcp->srcport)].head;
+#else
+  entry = g_active_tcp_connections.head;
+#endif
+
+  while (entry)
     {
+      conn = tcp_entry2conn(entry);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -225,19 +333,17 @@ static inline FAR struct tcp_conn_s *
            net_ipv4addr_cmp(destipaddr, conn->u.ipv4.laddr)) &&
           net_ipv4addr_cmp(srcipaddr, conn->u.ipv4.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      entry = entry->flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -259,15 +365,24 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
-  while (conn)
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  entry = g_tcp_conn_hash[tcp_hash(tcp_ipv6_fold(ip->srcipaddr),
+                                   tcp->destport, tcp->srcport)].head;
+#else
+  entry = g_active_tcp_connections.head;
+#endif
+
+  while (entry)
     {
+      conn = tcp_entry2conn(entry);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -292,19 +407,17 @@ static inline FAR struct tcp_conn_s *
            net_ipv6addr_cmp(*destipaddr, conn->u.ipv6.laddr)) &&
           net_ipv6addr_cmp(*srcipaddr, conn->u.ipv6.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      entry = entry->flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -809,9 +922,6 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 {
   FAR struct devif_callback_s *cb;
   FAR struct devif_callback_s *next;
-#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
-  FAR struct tcp_wrbuffer_s *wrbuffer;
-#endif
 
   /* Because g_free_tcp_connections is accessed from user level and event
    * processing logic, it is necessary to keep the network locked during this
@@ -860,24 +970,22 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      dq_rem(&conn->hash_node, tcp_conn_bucket(conn));
+#endif
     }
 
+#ifdef CONFIG_NETDEV_TXREADY
+  tcp_txready_remove(conn);
+#endif
+
   tcp_free_rx_buffers(conn);
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Release any write buffers attached to the connection */
 
-  while ((wrbuffer = (struct tcp_wrbuffer_s *)
-                     sq_remfirst(&conn->write_q)) != NULL)
-    {
-      tcp_wrbuffer_release(wrbuffer);
-    }
-
-  while ((wrbuffer = (struct tcp_wrbuffer_s *)
-                     sq_remfirst(&conn->unacked_q)) != NULL)
-    {
-      tcp_wrbuffer_release(wrbuffer);
-    }
+  tcp_wrbuffer_release_queue(&conn->write_q);
+  tcp_wrbuffer_release_queue(&conn->unacked_q);
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
@@ -1156,7 +1264,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_addactive(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1467,7 +1575,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_addactive(conn);
   ret = OK;
 
 errout_with_lock:
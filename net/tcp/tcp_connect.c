@@ -351,6 +351,7 @@ int psock_tcp_connect(FAR struct socket *psock,
 
       /* Notify the device driver that new connection is available. */
 
+      tcp_txready(conn);
       netdev_txnotify_dev(conn->dev);
 
       /* Non-blocking connection ? set the socket error
@@ -128,4 +128,54 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: tcp_txready
+ *
+ * Description:
+ *   Queue a TCP connection with pending TX work on the TX ready queue of
+ *   its device, so that the next devif_poll() of the device polls it.  The
+ *   caller still notifies the device driver.
+ *
+ * Input Parameters:
+ *   conn - The TCP "connection" with TX work
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void tcp_txready(FAR struct tcp_conn_s *conn)
+{
+  if (conn->dev != NULL && conn->txready_dev != conn->dev)
+    {
+      tcp_txready_remove(conn);
+
+      dq_addlast(&conn->txready_node, &conn->dev->d_tcpready);
+      conn->txready_dev = conn->dev;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_txready_remove
+ *
+ * Description:
+ *   Remove a TCP connection from the TX ready queue of its device, if it
+ *   is queued.
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_txready_remove(FAR struct tcp_conn_s *conn)
+{
+  if (conn->txready_dev != NULL)
+    {
+      dq_rem(&conn->txready_node, &conn->txready_dev->d_tcpready);
+      conn->txready_dev = NULL;
+    }
+}
+#endif /* CONFIG_NETDEV_TXREADY */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -67,6 +67,16 @@
 
 #define IPDATA(hl) (*(FAR uint8_t *)IPBUF(hl))
 
+/* Segments coalesced by netdev_gro_receive() had their checksums verified
+ * one by one on reception.
+ */
+
+#ifdef CONFIG_NETDEV_GRO
+#  define TCP_CHKSUM_VERIFIED(dev) ((dev)->d_grochksum)
+#else
+#  define TCP_CHKSUM_VERIFIED(dev) false
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -726,7 +736,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 #ifdef CONFIG_NET_TCP_CHECKSUMS
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!TCP_CHKSUM_VERIFIED(dev) && tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -50,6 +50,7 @@
 #include <stdbool.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 
@@ -57,13 +58,31 @@
 #include "inet/inet.h"
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_LISTEN_HASHMASK  (CONFIG_NET_TCP_LISTEN_HASHSIZE - 1)
+#  define tcp_listen_bucket(p) \
+     (&g_tcp_listenhash[NTOHS(p) & TCP_LISTEN_HASHMASK])
+#  define tcp_listen_conn(e)   container_of(e, struct tcp_conn_s, listen_node)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The listeners hashed by local port, and their number */
+
+static dq_queue_t g_tcp_listenhash[CONFIG_NET_TCP_LISTEN_HASHSIZE];
+static int g_tcp_nlisteners;
+#else
 /* The tcp_listenports list all currently listening ports. */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -89,17 +108,29 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_entry_t *entry = tcp_listen_bucket(portno)->head;
+
+  /* Examine each listener whose local port has the same hash */
+
+  for (; entry != NULL; entry = entry->flink)
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
 
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+#endif
     {
       /* Is this slot assigned?  If so, does the connection have the same
        * local port number?
        */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      FAR struct tcp_conn_s *conn = tcp_listen_conn(entry);
+#else
       FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       if (conn && conn->lport == portno && conn->domain == domain)
 #else
@@ -160,10 +191,28 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_queue_t *bucket;
+  FAR dq_entry_t *entry;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  bucket = tcp_listen_bucket(conn->lport);
+  for (entry = bucket->head; entry != NULL; entry = entry->flink)
+    {
+      if (tcp_listen_conn(entry) == conn)
+        {
+          dq_rem(entry, bucket);
+          g_tcp_nlisteners--;
+          ret = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -173,6 +222,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -191,7 +241,9 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+#ifndef CONFIG_NET_TCP_CONN_HASH
   int ndx;
+#endif
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -220,6 +272,16 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      /* Add the connection to the bucket of its local port */
+
+      if (g_tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
+        {
+          dq_addlast(&conn->listen_node, tcp_listen_bucket(conn->lport));
+          g_tcp_nlisteners++;
+          ret = OK;
+        }
+#else
       /* Search all slots until an available slot is found */
 
       for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
@@ -235,6 +297,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
@@ -839,6 +839,7 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
 
   if (tcp_should_send_recvwindow(conn))
     {
+      tcp_txready(conn);
       netdev_txnotify_dev(conn->dev);
     }
 
@@ -266,9 +266,6 @@ static void retransmit_segment(FAR struct tcp_conn_s *conn,
 static inline void psock_lost_connection(FAR struct tcp_conn_s *conn,
                                          bool abort)
 {
-  FAR sq_entry_t *entry;
-  FAR sq_entry_t *next;
-
   /* Do not allow any further callbacks */
 
   if (conn->sndcb != NULL)
@@ -279,17 +276,8 @@ static inline void psock_lost_connection(FAR struct tcp_conn_s *conn,
 
   /* Free all queued write buffers */
 
-  for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
-    {
-      next = sq_next(entry);
-      tcp_wrbuffer_release((FAR struct tcp_wrbuffer_s *)entry);
-    }
-
-  for (entry = sq_peek(&conn->write_q); entry; entry = next)
-    {
-      next = sq_next(entry);
-      tcp_wrbuffer_release((FAR struct tcp_wrbuffer_s *)entry);
-    }
+  tcp_wrbuffer_release_queue(&conn->unacked_q);
+  tcp_wrbuffer_release_queue(&conn->write_q);
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
@@ -411,6 +399,36 @@ static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: tcp_max_sndlen
+ *
+ * Description:
+ *   Return the largest amount of new data to send in one packet:  One MSS,
+ *   or with TCP large send several MSS when the device is being polled.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_max_sndlen(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn, uint16_t flags)
+{
+#ifdef CONFIG_NET_TCP_TSO
+  uint32_t maxlen;
+
+  if ((flags & TCP_POLL) == 0)
+    {
+      return conn->mss;
+    }
+
+  maxlen = dev->d_tsomax != 0 ? dev->d_tsomax :
+           UINT16_MAX - NET_LL_HDRLEN(dev);
+  maxlen = MIN(maxlen - tcpip_hdrsize(conn),
+               (uint32_t)CONFIG_NET_TCP_TSO_MAXSEGS * conn->mss);
+  return MAX(maxlen, conn->mss);
+#else
+  return conn->mss;
+#endif
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -609,6 +627,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
                       TCP_WBNACK(wrb) = 0;
                       conn->timeout = true;
+                      tcp_txready(conn);
                       netdev_txnotify_dev(conn->dev);
                       return flags;
                     }
@@ -1040,9 +1059,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > tcp_max_sndlen(dev, conn, flags))
             {
-              sndlen = conn->mss;
+              sndlen = tcp_max_sndlen(dev, conn, flags);
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1067,6 +1086,18 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = CONFIG_IOB_BUFSIZE;
             }
 
+#ifdef CONFIG_NET_TCP_TSO
+          /* Cutting a large packet into segments takes as many IOBs again */
+
+          if (sndlen > conn->mss && dev->d_tsomax == 0 &&
+              2 * sndlen > iob_navail(false) * CONFIG_IOB_BUFSIZE)
+            {
+              sndlen = conn->mss;
+            }
+
+          dev->d_gsosize = sndlen > conn->mss ? conn->mss : 0;
+#endif
+
           ninfo("SEND: wrb=%p seq=%" PRIu32 " pktlen=%u sent=%u sndlen=%zu "
                 "mss=%u snd_wnd=%" PRIu32 " seq=%" PRIu32
                 " remaining_snd_wnd=%" PRIu32 "\n",
@@ -1110,6 +1141,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                                TCP_WBSENT(wrb), tcpip_hdrsize(conn));
           if (ret <= 0)
             {
+#ifdef CONFIG_NET_TCP_TSO
+              dev->d_gsosize = 0;
+#endif
               return flags;
             }
 
@@ -1197,9 +1231,13 @@ static uint32_t tcp_max_wrb_size(FAR struct tcp_conn_s *conn)
   const uint32_t mss = conn->mss;
   uint32_t size;
 
-  /* a few segments should be fine */
+  /* a few segments should be fine, or a full large send */
 
+#ifdef CONFIG_NET_TCP_TSO
+  size = CONFIG_NET_TCP_TSO_MAXSEGS * mss;
+#else
   size = 4 * mss;
+#endif
 
   /* but it should not hog too many IOB buffers */
 
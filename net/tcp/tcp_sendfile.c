@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -45,6 +46,8 @@
 #include <nuttx/sched.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/mm/map.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/tcp.h>
@@ -90,12 +93,106 @@ struct sendfile_s
 #endif
   int                snd_dup_acks;         /* Duplicate ACK counter */
 #endif
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR const uint8_t *snd_map;              /* The file data mapped in
+                                            * memory
+                                            */
+  struct iob_ref_s   snd_ref;              /* References to the mapping */
+  sem_t              snd_refsem;           /* Posted when no packet refers
+                                            * to the mapping any longer
+                                            */
+#endif
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+/****************************************************************************
+ * Name: sendfile_map
+ *
+ * Description:
+ *   Map the file data to send in memory, if the file system gives direct
+ *   access to it.  The file systems without mmap() support are not asked,
+ *   the generic fallback would copy all the data to the heap.
+ *
+ * Returned Value:
+ *   The address of the data, or NULL if it must be read.  'unmap' tells
+ *   whether the mapping must be undone with file_munmap().
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *sendfile_map(FAR struct file *filep, off_t offset,
+                                       size_t count, FAR bool *unmap)
+{
+  FAR struct inode *inode = filep->f_inode;
+  struct mm_map_entry_s entry;
+
+  if (count == 0 || inode == NULL || inode->u.i_ops == NULL ||
+      inode->u.i_ops->mmap == NULL || (filep->f_oflags & O_RDOK) == 0)
+    {
+      return NULL;
+    }
+
+  memset(&entry, 0, sizeof(entry));
+  entry.length = count;
+  entry.offset = offset;
+  entry.prot   = PROT_READ;
+  entry.flags  = MAP_SHARED;
+
+  if (inode->u.i_ops->mmap(filep, &entry) < 0 || entry.vaddr == NULL)
+    {
+      return NULL;
+    }
+
+  *unmap = entry.munmap != NULL;
+  return entry.vaddr;
+}
+
+/****************************************************************************
+ * Name: sendfile_ref_release
+ *
+ * Description:
+ *   Called when the last reference to the mapped file data is dropped.
+ *
+ ****************************************************************************/
+
+static void sendfile_ref_release(FAR void *arg)
+{
+  FAR struct sendfile_s *pstate = arg;
+
+  nxsem_post(&pstate->snd_refsem);
+}
+#endif
+
+/****************************************************************************
+ * Name: sendfile_send
+ *
+ * Description:
+ *   Set up to send 'sndlen' bytes of the file data starting 'pos' bytes
+ *   after the initial offset:  From the mapping if the file is mapped,
+ *   else read into the packet.
+ *
+ ****************************************************************************/
+
+static int sendfile_send(FAR struct net_driver_s *dev,
+                         FAR struct sendfile_s *pstate,
+                         uint32_t sndlen, uint32_t pos)
+{
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  if (pstate->snd_map != NULL)
+    {
+      return devif_ref_send(dev, &pstate->snd_ref, pstate->snd_map + pos,
+                            sndlen, tcpip_hdrsize(pstate->snd_conn));
+    }
+#endif
+
+  return devif_file_send(dev, pstate->snd_file, sndlen,
+                         pstate->snd_foffset + pos,
+                         tcpip_hdrsize(pstate->snd_conn));
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -269,9 +366,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                            pstate->snd_foffset + pstate->snd_acked,
-                            tcpip_hdrsize(conn));
+      ret = sendfile_send(dev, pstate, sndlen, pstate->snd_acked);
       if (ret < 0)
         {
           nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -340,9 +435,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                                pstate->snd_foffset + pstate->snd_sent,
-                                tcpip_hdrsize(conn));
+          ret = sendfile_send(dev, pstate, sndlen, pstate->snd_sent);
           if (ret < 0)
             {
               nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -419,6 +512,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
   off_t startpos;
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR const uint8_t *map;
+  bool unmap = false;
+#endif
   int ret = OK;
 
   conn = psock->s_conn;
@@ -470,6 +567,12 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* Map the file data before locking the network, mapping may block */
+
+  map = sendfile_map(infile, offset ? *offset : startpos, count, &unmap);
+#endif
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -487,6 +590,15 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  state.snd_map     = map;                         /* Mapped file data */
+  if (map != NULL)
+    {
+      nxsem_init(&state.snd_refsem, 0, 0);
+      iob_ref_init(&state.snd_ref, sendfile_ref_release, &state);
+    }
+#endif
+
   /* Allocate resources to receive a callback */
 
   state.snd_cb = tcp_callback_alloc(conn);
@@ -545,6 +657,39 @@ errout_locked:
 #endif
   net_unlock();
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  if (map != NULL)
+    {
+      /* Wait until the packets that still reference the file data, e.g.
+       * in the transmit queue of the driver, are freed.
+       */
+
+      iob_ref_put(&state.snd_ref);
+      nxsem_wait_uninterruptible(&state.snd_refsem);
+      nxsem_destroy(&state.snd_refsem);
+
+      if (unmap)
+        {
+          file_munmap((FAR void *)map, count);
+        }
+
+      /* Nothing was read, move the file position past the data sent as
+       * the reads would have.
+       */
+
+      if (state.snd_sent > 0)
+        {
+          off_t curpos = file_seek(infile,
+                                   state.snd_foffset + state.snd_sent,
+                                   SEEK_SET);
+          if (curpos < 0)
+            {
+              return curpos;
+            }
+        }
+    }
+#endif
+
   /* Return the current file position */
 
   if (offset)
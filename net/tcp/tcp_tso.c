@@ -0,0 +1,211 @@
+/****************************************************************************
+ * net/tcp/tcp_tso.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "utils/utils.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_TSO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_tso_fixup
+ *
+ * Description:
+ *   Update the IP and TCP headers of the segment in d_iob, which are a copy
+ *   of the headers of the large packet:  Lengths, IPv4 identification,
+ *   sequence number, flags and checksums.
+ *
+ ****************************************************************************/
+
+static void tcp_tso_fixup(FAR struct net_driver_s *dev, unsigned int iplen,
+                          uint16_t ipid, uint32_t seqno, uint8_t flags)
+{
+  FAR struct tcp_hdr_s *tcp = IPBUF(iplen);
+  unsigned int len = dev->d_iob->io_pktlen;
+
+#ifdef CONFIG_NET_IPv4
+  if (iplen == IPv4_HDRLEN)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      ipv4->len[0]   = len >> 8;
+      ipv4->len[1]   = len & 0xff;
+      ipv4->ipid[0]  = ipid >> 8;
+      ipv4->ipid[1]  = ipid & 0xff;
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (iplen == IPv6_HDRLEN)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      len          -= IPv6_HDRLEN;
+      ipv6->len[0]  = len >> 8;
+      ipv6->len[1]  = len & 0xff;
+    }
+#endif
+
+  tcp_setsequence(tcp->seqno, seqno);
+  tcp->flags     = flags;
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  tcp->tcpchksum = ~tcp_chksum(dev);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_tso_segment
+ *
+ * Description:
+ *   Cut the large TCP packet in d_iob into segments of d_gsosize bytes of
+ *   data and queue them in d_fragout, from where they are sent like IP
+ *   fragments.  PSH and FIN are kept on the last segment only.
+ *
+ * Input Parameters:
+ *   dev - The network device holding the packet in d_iob
+ *
+ * Returned Value:
+ *   OK on success, d_iob is then released.  A negated errno value if no
+ *   segment could be queued; the segments not sent are retransmitted by
+ *   the TCP logic.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_tso_segment(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *pkt = dev->d_iob;
+  FAR struct iob_s *seg;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int mss = dev->d_gsosize;
+  unsigned int iplen;
+  unsigned int hdrlen;
+  unsigned int datalen;
+  unsigned int offset;
+  unsigned int seglen;
+  uint16_t ipid = 0;
+  uint32_t seqno;
+  uint8_t flags;
+  int nsegs = 0;
+
+  dev->d_gsosize = 0;
+
+#ifdef CONFIG_NET_IPv6
+  iplen = IFF_IS_IPv6(dev->d_flags) ? IPv6_HDRLEN : IPv4_HDRLEN;
+#else
+  iplen = IPv4_HDRLEN;
+#endif
+
+#ifdef CONFIG_NET_IPv4
+  if (iplen == IPv4_HDRLEN)
+    {
+      ipid = (IPv4BUF->ipid[0] << 8) | IPv4BUF->ipid[1];
+    }
+#endif
+
+  tcp     = IPBUF(iplen);
+  hdrlen  = iplen + ((tcp->tcpoffset >> 4) << 2);
+  datalen = pkt->io_pktlen - hdrlen;
+  seqno   = tcp_getsequence(tcp->seqno);
+  flags   = tcp->flags;
+
+  /* Take the packet away from the device, the segments take its place one
+   * after the other.
+   */
+
+  netdev_iob_clear(dev);
+
+  for (offset = 0; offset < datalen; offset += seglen)
+    {
+      seglen = MIN(mss, datalen - offset);
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          break;
+        }
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      if (iob_clone_partial(pkt, hdrlen, 0, seg, 0, false, false) < 0 ||
+          iob_clone_partial(pkt, seglen, hdrlen + offset, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      dev->d_iob = seg;
+      tcp_tso_fixup(dev, iplen, ipid + nsegs, seqno + offset,
+                    offset + seglen < datalen ?
+                    flags & ~(TCP_PSH | TCP_FIN) : flags);
+      dev->d_iob = NULL;
+
+      if (iob_tryadd_queue(seg, &dev->d_fragout) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      nsegs++;
+    }
+
+  iob_free_chain(pkt);
+
+  if (offset < datalen)
+    {
+      nwarn("WARNING: %u of %u bytes left unsent, out of IOBs\n",
+            datalen - offset, datalen);
+    }
+
+  return nsegs > 0 ? OK : -ENOMEM;
+}
+
+#endif /* CONFIG_NET_TCP_TSO */
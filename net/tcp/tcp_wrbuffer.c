@@ -237,6 +237,62 @@ uint32_t tcp_wrbuffer_inqueue_size(FAR struct tcp_conn_s *conn)
 }
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+/****************************************************************************
+ * Name: tcp_wrbuffer_release_queue
+ *
+ * Description:
+ *   Release all of the TCP write buffers in a queue.  The I/O buffer chains
+ *   of all write buffers are gathered into one chain, so that they are
+ *   returned with one acquisition of the IOB lock.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_wrbuffer_release_queue(FAR sq_queue_t *queue)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
+  FAR sq_entry_t *entry;
+
+  for (entry = sq_peek(queue); entry != NULL; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (wrb->wb_iob != NULL)
+        {
+          if (tail == NULL)
+            {
+              head = wrb->wb_iob;
+            }
+          else
+            {
+              tail->io_flink = wrb->wb_iob;
+            }
+
+          for (tail = wrb->wb_iob; tail->io_flink != NULL;
+               tail = tail->io_flink);
+
+          wrb->wb_iob = NULL;
+        }
+    }
+
+  /* To avoid deadlocks, we must following this ordering:  Release the I/O
+   * buffer chains first, then the write buffer structures.
+   */
+
+  if (head != NULL)
+    {
+      iob_free_chain(head);
+    }
+
+  while ((wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(queue)) != NULL)
+    {
+      tcp_wrbuffer_release(wrb);
+    }
+}
+
 /****************************************************************************
  * Name: tcp_wrbuffer_test
  *
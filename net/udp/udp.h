@@ -58,6 +58,12 @@
 #  else
 #    define UDP_WBDUMP(msg,wrb,len,offset)
 #  endif
+
+/* The payload of a write buffer is summed while it is copied in */
+
+#  if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+#    define UDP_COPY_CHKSUM 1
+#  endif
 #endif
 
 /* Allocate a new UDP data callback */
@@ -117,6 +123,17 @@ struct udp_conn_s
   uint8_t  domain;        /* IP domain: PF_INET or PF_INET6 */
   uint8_t  crefs;         /* Reference counts on this instance */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  dq_entry_t hash_node;   /* Entry in the bucket of lport, if not zero */
+#endif
+
+#ifdef CONFIG_NETDEV_TXREADY
+  /* Entry in the d_udpready queue of txready_dev, if not NULL */
+
+  dq_entry_t txready_node;
+  FAR struct net_driver_s *txready_dev;
+#endif
+
 #if CONFIG_NET_RECV_BUFSIZE > 0
   int32_t  rcvbufs;       /* Maximum amount of bytes queued in recv */
 #endif
@@ -147,6 +164,15 @@ struct udp_conn_s
   /* Callback instance for UDP sendto() */
 
   FAR struct devif_callback_s *sndcb;
+
+#ifdef UDP_COPY_CHKSUM
+  /* The raw checksum of the payload of the write buffer being sent, valid
+   * from the send callback until udp_send() if sndsummed is set.
+   */
+
+  uint16_t sndchksum;
+  bool     sndsummed;
+#endif
 #endif
 
 #if defined(CONFIG_NET_IGMP) || defined(CONFIG_NET_MLD)
@@ -174,6 +200,9 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+#ifdef UDP_COPY_CHKSUM
+  uint16_t wb_chksum;              /* Raw checksum of the payload */
+#endif
 };
 #endif
 
@@ -234,6 +263,20 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain);
 
 void udp_free(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Bind a UDP connection to the local port 'portno' (network byte order),
+ *   or unbind it if 'portno' is zero.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno);
+
 /****************************************************************************
  * Name: udp_active
  *
@@ -263,6 +306,26 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 
 FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_reuseport
+ *
+ * Description:
+ *   If the connection 'conn' found by udp_active() has SO_REUSEPORT set,
+ *   select the member of its group of connections that receives the
+ *   datagram by a hash of the source address and port, so that a flow
+ *   always goes to the same socket.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport(FAR struct net_driver_s *dev,
+                                     FAR struct udp_conn_s *conn,
+                                     FAR struct udp_hdr_s *udp);
+#endif
+
 /****************************************************************************
  * Name: udp_select_port
  *
@@ -410,6 +473,45 @@ void udp_ipv6_select(FAR struct net_driver_s *dev);
 
 void udp_poll(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_txready
+ *
+ * Description:
+ *   Queue a UDP connection with pending TX work on the TX ready queue of
+ *   the device 'dev', so that the next devif_poll() of the device polls
+ *   it.  The caller still notifies the device driver.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The UDP "connection" with TX work
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void udp_txready(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn);
+#else
+#  define udp_txready(dev, conn)
+#endif
+
+/****************************************************************************
+ * Name: udp_txready_remove
+ *
+ * Description:
+ *   Remove a UDP connection from the TX ready queue of its device, if it
+ *   is queued.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void udp_txready_remove(FAR struct udp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_cansend
  *
@@ -59,6 +59,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -82,6 +83,11 @@
 #  define CONFIG_NET_UDP_MAX_CONNS 0
 #endif
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+#  define UDP_CONN_HASHMASK  (CONFIG_NET_UDP_CONN_HASHSIZE - 1)
+#  define udp_port_bucket(p) (&g_udp_conn_hash[NTOHS(p) & UDP_CONN_HASHMASK])
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -97,10 +103,44 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The bound connections, hashed by local port */
+
+static dq_queue_t g_udp_conn_hash[CONFIG_NET_UDP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_nextport
+ *
+ * Description:
+ *   Traverse the UDP connections that may be bound to the local port
+ *   'portno':  Only the connections of the hash bucket of the port if the
+ *   connections are hashed, all the allocated connections otherwise.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *
+udp_nextport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR dq_entry_t *entry;
+
+  entry = conn == NULL ? udp_port_bucket(portno)->head :
+                         conn->hash_node.flink;
+  return entry == NULL ? NULL :
+         container_of(entry, struct udp_conn_s, hash_node);
+#else
+  return udp_nextconn(conn);
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -126,14 +166,16 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   FAR struct udp_conn_s *conn = NULL;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
 #endif
 
   /* Now search each connection structure. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  while ((conn = udp_nextport(conn, portno)) != NULL)
     {
       /* With SO_REUSEADDR set for both sockets, we do not need to check its
-       * address and port.
+       * address and port.  Neither with SO_REUSEPORT, both sockets then
+       * belong to the same group.
        */
 
 #ifdef CONFIG_NET_SOCKOPTS
@@ -141,6 +183,11 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
         {
           continue;
         }
+
+      if (skip_reuseport && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          continue;
+        }
 #endif
 
       /* If the port local port number assigned to the connections matches
@@ -203,7 +250,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextport(conn, udp->destport);
 
   while (conn)
     {
@@ -317,7 +364,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_nextport(conn, udp->destport);
     }
 
   return conn;
@@ -343,7 +390,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextport(conn, udp->destport);
 
   while (conn != NULL)
     {
@@ -457,13 +504,64 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_nextport(conn, udp->destport);
     }
 
   return conn;
 }
 #endif /* CONFIG_NET_IPv6 */
 
+/****************************************************************************
+ * Name: udp_flowhash
+ *
+ * Description:
+ *   Return a hash of the source address and port of the received UDP
+ *   datagram.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static uint32_t udp_flowhash(FAR struct net_driver_s *dev,
+                             FAR struct udp_hdr_s *udp)
+{
+  FAR const uint16_t *srcipaddr;
+  uint32_t hash = udp->srcport;
+  int naddr16;
+  int i;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      srcipaddr = IPv6BUF->srcipaddr;
+      naddr16   = 8;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      srcipaddr = IPv4BUF->srcipaddr;
+      naddr16   = 2;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  for (i = 0; i < naddr16; i++)
+    {
+      hash = (hash << 5) + hash + srcipaddr[i];
+    }
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -580,6 +678,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       conn->domain      = domain;
 #endif
       conn->lport       = 0;
+#ifdef CONFIG_NETDEV_TXREADY
+      conn->txready_dev = NULL;
+#endif
 #if CONFIG_NET_RECV_BUFSIZE > 0
       conn->rcvbufs     = CONFIG_NET_RECV_BUFSIZE;
 #endif
@@ -623,12 +724,16 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   nxmutex_lock(&g_free_lock);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
   dq_rem(&conn->sconn.node, &g_active_udp_connections);
 
+#ifdef CONFIG_NETDEV_TXREADY
+  udp_txready_remove(conn);
+#endif
+
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
 
   iob_free_chain(conn->readahead);
@@ -657,6 +762,37 @@ void udp_free(FAR struct udp_conn_s *conn)
   nxmutex_unlock(&g_free_lock);
 }
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Bind a UDP connection to the local port 'portno' (network byte order),
+ *   or unbind it if 'portno' is zero.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  /* Move the connection to the bucket of its new port */
+
+  if (conn->lport != 0)
+    {
+      dq_rem(&conn->hash_node, udp_port_bucket(conn->lport));
+    }
+
+  if (portno != 0)
+    {
+      dq_addlast(&conn->hash_node, udp_port_bucket(portno));
+    }
+#endif
+
+  conn->lport = portno;
+}
+
 /****************************************************************************
  * Name: udp_active
  *
@@ -715,6 +851,60 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_reuseport
+ *
+ * Description:
+ *   If the connection 'conn' found by udp_active() has SO_REUSEPORT set,
+ *   select the member of its group of connections that receives the
+ *   datagram by a hash of the source address and port, so that a flow
+ *   always goes to the same socket.  The group is made of all the
+ *   connections with SO_REUSEPORT set that accept the datagram.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport(FAR struct net_driver_s *dev,
+                                     FAR struct udp_conn_s *conn,
+                                     FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *next;
+  uint32_t member;
+  uint32_t nmembers = 0;
+
+  if (!_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+    {
+      return conn;
+    }
+
+  /* Count the members of the group */
+
+  for (next = conn; next != NULL; next = udp_active(dev, next, udp))
+    {
+      if (_SO_GETOPT(next->sconn.s_options, SO_REUSEPORT))
+        {
+          nmembers++;
+        }
+    }
+
+  /* And select one of them */
+
+  member = udp_flowhash(dev, udp) % nmembers;
+  for (next = conn; next != NULL; next = udp_active(dev, next, udp))
+    {
+      if (_SO_GETOPT(next->sconn.s_options, SO_REUSEPORT) && member-- == 0)
+        {
+          break;
+        }
+    }
+
+  return next;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -852,7 +1042,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         }
       else
         {
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
     }
@@ -877,7 +1067,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
       else
@@ -929,7 +1119,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
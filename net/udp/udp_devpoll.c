@@ -115,4 +115,55 @@ void udp_poll(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
   dev->d_len   = 0;
 }
 
+/****************************************************************************
+ * Name: udp_txready
+ *
+ * Description:
+ *   Queue a UDP connection with pending TX work on the TX ready queue of
+ *   the device 'dev', so that the next devif_poll() of the device polls
+ *   it.  The caller still notifies the device driver.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The UDP "connection" with TX work
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TXREADY
+void udp_txready(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
+{
+  if (dev != NULL && conn->txready_dev != dev)
+    {
+      udp_txready_remove(conn);
+
+      dq_addlast(&conn->txready_node, &dev->d_udpready);
+      conn->txready_dev = dev;
+    }
+}
+
+/****************************************************************************
+ * Name: udp_txready_remove
+ *
+ * Description:
+ *   Remove a UDP connection from the TX ready queue of its device, if it
+ *   is queued.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void udp_txready_remove(FAR struct udp_conn_s *conn)
+{
+  if (conn->txready_dev != NULL)
+    {
+      dq_rem(&conn->txready_node, &conn->txready_dev->d_udpready);
+      conn->txready_dev = NULL;
+    }
+}
+#endif /* CONFIG_NETDEV_TXREADY */
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
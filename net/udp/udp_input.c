@@ -289,6 +289,17 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
       conn = udp_active(dev, NULL, udp);
       if (conn)
         {
+#ifdef CONFIG_NET_SOCKOPTS
+          /* A unicast datagram goes to one member of a SO_REUSEPORT group */
+
+#  ifdef CONFIG_NET_BROADCAST
+          if (!udp_is_broadcast(dev))
+#  endif
+            {
+              conn = udp_reuseport(dev, conn, udp);
+            }
+#endif
+
           /* We'll only get multiple conn when we support SO_REUSEADDR */
 
 #if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_BROADCAST)
@@ -250,6 +250,18 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
 #ifdef CONFIG_NET_UDP_CHECKSUMS
       /* Calculate UDP checksum. */
 
+#ifdef UDP_COPY_CHKSUM
+      if (conn->sndsummed)
+        {
+          /* The payload was summed when it was copied into the write
+           * buffer.
+           */
+
+          conn->sndsummed = false;
+          udp->udpchksum  = ~udp_chksum_summed(dev, conn->sndchksum);
+        }
+      else
+#endif
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
       if (IFF_IS_IPv4(dev->d_flags))
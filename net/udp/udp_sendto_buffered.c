@@ -85,6 +85,20 @@
 #  define UDP_WBDUMP(msg,wrb,len,offset)
 #endif
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of summing the payload while it is copied in */
+
+#ifdef UDP_COPY_CHKSUM
+struct sendto_chksum_s
+{
+  uint16_t sum;                    /* Raw checksum so far */
+  bool     odd;                    /* An odd number of bytes was summed */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -258,7 +272,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
@@ -340,6 +354,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
 
   /* Notify the device driver of the availability of TX data */
 
+  udp_txready(dev, conn);
   netdev_txnotify_dev(dev);
   return OK;
 }
@@ -457,6 +472,13 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
       wrb->wb_iob = NULL;
 
+#ifdef UDP_COPY_CHKSUM
+      /* Let udp_send() use the sum of the payload */
+
+      conn->sndchksum = wrb->wb_chksum;
+      conn->sndsummed = true;
+#endif
+
 #ifdef NEED_IPDOMAIN_SUPPORT
       /* If both IPv4 and IPv6 support are enabled, then we will need to
        * select which one to use when generating the outgoing packet.
@@ -513,6 +535,59 @@ static unsigned int udp_send_gettimeout(clock_t start, unsigned int timeout)
   return timeout;
 }
 
+/****************************************************************************
+ * Name: sendto_copy_chksum
+ *
+ * Description:
+ *   Copy a part of the payload into the write buffer and add it to the
+ *   checksum in the same pass.
+ *
+ ****************************************************************************/
+
+#ifdef UDP_COPY_CHKSUM
+static void sendto_copy_chksum(FAR uint8_t *dest, FAR const uint8_t *src,
+                               unsigned int len, FAR void *arg)
+{
+  FAR struct sendto_chksum_s *chk = arg;
+
+  chk->sum = chksum_copy(chk->sum, dest, src, len, &chk->odd);
+}
+#endif
+
+/****************************************************************************
+ * Name: sendto_copyin
+ *
+ * Description:
+ *   Copy the payload into the write buffer at 'offset', summing it on the
+ *   way if UDP checksums are computed.
+ *
+ ****************************************************************************/
+
+static int sendto_copyin(FAR struct udp_wrbuffer_s *wrb,
+                         FAR const void *buf, size_t len, int offset,
+                         bool can_block)
+{
+#ifdef UDP_COPY_CHKSUM
+  struct sendto_chksum_s chk;
+  int ret;
+
+  chk.sum = 0;
+  chk.odd = false;
+
+  ret = iob_copyin_cb(wrb->wb_iob, buf, len, offset, false, can_block,
+                      sendto_copy_chksum, &chk);
+  wrb->wb_chksum = chk.sum;
+  return ret;
+#else
+  if (can_block)
+    {
+      return iob_copyin(wrb->wb_iob, buf, len, offset, false);
+    }
+
+  return iob_trycopyin(wrb->wb_iob, buf, len, offset, false);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -819,8 +894,7 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
       if (nonblock)
         {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                              len, udpiplen, false);
+          ret = sendto_copyin(wrb, buf, len, udpiplen, false);
         }
       else
         {
@@ -833,8 +907,7 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
            */
 
           blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                           len, udpiplen, false);
+          ret = sendto_copyin(wrb, buf, len, udpiplen, true);
           if (blresult >= 0)
             {
               net_restorelock(count);
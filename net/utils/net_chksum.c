@@ -27,12 +27,193 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
 #include "utils/utils.h"
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHKSUM_WORDSIZE   sizeof(chksum_word_t)
+#define CHKSUM_WORDMASK   (CHKSUM_WORDSIZE - 1)
+#define CHKSUM_SWAP(s)    ((uint16_t)(((s) << 8) | ((s) >> 8)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The data is summed one machine word at a time into a 64-bit
+ * accumulator.  The 32-bit words cannot carry out of the accumulator for
+ * the 64 KiB at most summed at once, the 64-bit ones add their carry back.
+ */
+
+#if UINTPTR_MAX > UINT32_MAX
+typedef uint64_t chksum_word_t;
+#else
+typedef uint32_t chksum_word_t;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: chksum_addword
+ *
+ * Description:
+ *   Add one word to the accumulator, with the end-around carry.
+ *
+ ****************************************************************************/
+
+static inline uint64_t chksum_addword(uint64_t acc, chksum_word_t word)
+{
+  acc += word;
+#if UINTPTR_MAX > UINT32_MAX
+  acc += acc < word;
+#endif
+  return acc;
+}
+
+/****************************************************************************
+ * Name: chksum_fold
+ *
+ * Description:
+ *   Fold the accumulator to a 16-bit one's complement sum.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  return (uint16_t)acc;
+}
+
+/****************************************************************************
+ * Name: chksum_native
+ *
+ * Description:
+ *   Sum the data at an even address as 16-bit words in the byte order of
+ *   the CPU.  The one's complement sum does not depend on the byte order
+ *   (RFC1071), so after folding, swapping the bytes of the sum on a little
+ *   endian CPU gives the sum of the words in network order.  An odd byte
+ *   at the end is the high byte of a last word padded with zero.
+ *
+ ****************************************************************************/
+
+static uint64_t chksum_native(FAR const uint8_t *data, size_t len)
+{
+  FAR const chksum_word_t *word;
+  uint64_t acc = 0;
+  uint16_t last = 0;
+
+  /* Reach the alignment of a word */
+
+  while (len >= 2 && ((uintptr_t)data & CHKSUM_WORDMASK) != 0)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* The bulk of the data, four words per round */
+
+  word = (FAR const chksum_word_t *)data;
+  while (len >= 4 * CHKSUM_WORDSIZE)
+    {
+      acc  = chksum_addword(acc, word[0]);
+      acc  = chksum_addword(acc, word[1]);
+      acc  = chksum_addword(acc, word[2]);
+      acc  = chksum_addword(acc, word[3]);
+      word += 4;
+      len  -= 4 * CHKSUM_WORDSIZE;
+    }
+
+  while (len >= CHKSUM_WORDSIZE)
+    {
+      acc = chksum_addword(acc, *word++);
+      len -= CHKSUM_WORDSIZE;
+    }
+
+  data = (FAR const uint8_t *)word;
+  while (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      *(FAR uint8_t *)&last = *data;
+      acc += last;
+    }
+
+  return acc;
+}
+
+/****************************************************************************
+ * Name: chksum_block
+ *
+ * Description:
+ *   Return the sum of the data as 16-bit words in network order, the
+ *   first byte being the high byte of a word, in host byte order.
+ *
+ ****************************************************************************/
+
+static uint16_t chksum_block(FAR const uint8_t *data, size_t len)
+{
+  uint16_t first = 0;
+  uint16_t sum;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (((uintptr_t)data & 1) == 0)
+    {
+      return NTOHS(chksum_fold(chksum_native(data, len)));
+    }
+
+  /* From an odd address, the words summed start one byte late, which
+   * swaps the bytes of their sum.  The first byte is the high byte of a
+   * word of its own.
+   */
+
+  sum = chksum_fold(chksum_native(data + 1, len - 1));
+  *(FAR uint8_t *)&first = *data;
+
+  return NTOHS(chksum_fold((uint64_t)CHKSUM_SWAP(sum) + first));
+}
+
+/****************************************************************************
+ * Name: chksum_add
+ *
+ * Description:
+ *   Add two 16-bit one's complement sums.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
 /****************************************************************************
  * Name: checksum
  *
@@ -53,57 +234,28 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
                     uint16_t len, bool *odd)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
-
-  dataptr = data;
-  last_byte = data + len - 1;
-
-  if (*odd == true)
+  if (len == 0)
     {
-      t = dataptr[0];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
-
-      dataptr += 1;
-    }
-
-  while (dataptr < last_byte)
-    {
-      /* At least two more bytes */
-
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
-
-      dataptr += 2;
+      return sum;
     }
 
-  *odd = false;
+  /* The previous data ended in the middle of a word, the first byte is
+   * its low byte.
+   */
 
-  if (dataptr == last_byte)
+  if (*odd == true)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
-
-      *odd = true;
+      sum   = chksum_add(sum, data[0]);
+      data += 1;
+      len  -= 1;
     }
 
+  sum  = chksum_add(sum, chksum_block(data, len));
+  *odd = (len & 1) != 0;
+
   /* Return sum in host byte order. */
 
   return sum;
@@ -139,6 +291,77 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
   return checksum(sum, data, len, &odd);
 }
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy data and calculate its raw check sum in the same pass.  Like
+ *   checksum(), the sum may be carried over several calls, e.g. one per
+ *   buffer of an I/O buffer chain.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.  This
+ *          should be zero on the first call.
+ *   dest - Where to copy the data to.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data.
+ *   odd  - Whether the data of the previous calls had an odd length.
+ *          This should be false on the first call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd)
+{
+  FAR const chksum_word_t *sword;
+  FAR chksum_word_t *dword;
+  uint64_t acc = 0;
+  uint16_t head;
+  uint16_t body;
+  uint16_t part;
+
+  /* Only the words at the same alignment in both buffers are copied and
+   * summed together, the bytes around them are copied first.
+   */
+
+  head = -(uintptr_t)src & CHKSUM_WORDMASK;
+  if (head > len ||
+      (((uintptr_t)dest ^ (uintptr_t)src) & CHKSUM_WORDMASK) != 0)
+    {
+      head = len;
+    }
+
+  memcpy(dest, src, head);
+  sum   = checksum(sum, dest, head, odd);
+  dest += head;
+  src  += head;
+  len  -= head;
+
+  body  = len & ~CHKSUM_WORDMASK;
+  sword = (FAR const chksum_word_t *)src;
+  dword = (FAR chksum_word_t *)dest;
+
+  for (part = 0; part < body; part += CHKSUM_WORDSIZE)
+    {
+      chksum_word_t word = *sword++;
+
+      *dword++ = word;
+      acc      = chksum_addword(acc, word);
+    }
+
+  if (body > 0)
+    {
+      part = NTOHS(chksum_fold(acc));
+      sum  = chksum_add(sum, *odd ? CHKSUM_SWAP(part) : part);
+    }
+
+  memcpy(dest + body, src + body, len - body);
+  return checksum(sum, dest + body, len - body, odd);
+}
+
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
 /****************************************************************************
@@ -179,6 +179,25 @@ void net_unlock(void)
   nxrmutex_unlock(&g_netlock);
 }
 
+/****************************************************************************
+ * Name: net_lock_held
+ *
+ * Description:
+ *   Check whether the calling thread holds the network lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   true if the calling thread holds the network lock.
+ *
+ ****************************************************************************/
+
+bool net_lock_held(void)
+{
+  return nxrmutex_is_hold(&g_netlock);
+}
+
 /****************************************************************************
  * Name: net_breaklock
  *
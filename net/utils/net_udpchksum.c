@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/udp.h>
 
 #include "utils/utils.h"
 
@@ -65,4 +66,53 @@ uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: udp_chksum_summed
+ *
+ * Description:
+ *   Calculate the UDP checksum of the packet in d_buf, whose payload has
+ *   the raw checksum 'sum' already.  Only the pseudo-header and the UDP
+ *   header are read.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+uint16_t udp_chksum_summed(FAR struct net_driver_s *dev, uint16_t sum)
+{
+  FAR uint8_t *udp;
+  uint16_t hsum;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (IFF_IS_IPv4(dev->d_flags))
+#endif
+    {
+      hsum = ipv4_upperlayer_header_chksum(dev, IP_PROTO_UDP);
+      udp  = IPBUF(IPv4_HDRLEN);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      hsum = ipv6_upperlayer_header_chksum(dev, IP_PROTO_UDP, IPv6_HDRLEN);
+      udp  = IPBUF(IPv6_HDRLEN);
+    }
+#endif
+
+  /* The UDP header has an even length, so the payload sum adds as is */
+
+  hsum  = chksum(hsum, udp, UDP_HDRLEN);
+  hsum += sum;
+  if (hsum < sum)
+    {
+      hsum++; /* carry */
+    }
+
+  return (hsum == 0) ? 0xffff : HTONS(hsum);
+}
+#endif
+
 #endif /* CONFIG_NET_UDP */
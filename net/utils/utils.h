@@ -497,6 +497,20 @@ uint16_t udp_ipv4_chksum(FAR struct net_driver_s *dev);
 uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: udp_chksum_summed
+ *
+ * Description:
+ *   Calculate the UDP checksum of the packet in d_buf, whose payload has
+ *   the raw checksum 'sum' already.  Only the pseudo-header and the UDP
+ *   header are read.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+uint16_t udp_chksum_summed(FAR struct net_driver_s *dev, uint16_t sum);
+#endif
+
 /****************************************************************************
  * Name: icmp_chksum
  *
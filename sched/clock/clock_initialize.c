@@ -46,6 +46,9 @@
 #ifdef CONFIG_CLOCK_TIMEKEEPING
 #  include "clock/clock_timekeeping.h"
 #endif
+#ifdef CONFIG_SCHED_WORKSTEAL
+#  include "sched/sched.h"
+#endif
 
 /****************************************************************************
  * Public Data
@@ -239,6 +242,10 @@ void clock_initialize(void)
   cpuload_init();
 #endif
 
+#if defined(CONFIG_SCHED_WORKSTEAL) && CONFIG_SCHED_WORKSTEAL_INTERVAL > 0
+  nxsched_worksteal_initialize();
+#endif
+
   sched_trace_end();
 }
 
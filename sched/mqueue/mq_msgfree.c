@@ -48,6 +48,7 @@
  *   allocated dynamically it will be deallocated.
  *
  * Input Parameters:
+ *   msgq  - The message queue the message was allocated for
  *   mqmsg - message to free
  *
  * Returned Value:
@@ -55,7 +56,8 @@
  *
  ****************************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
 {
   irqstate_t flags;
 
@@ -89,6 +91,19 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
       spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
+#ifdef CONFIG_MQ_SLAB
+  /* If this message belongs to the slab of the message queue, then put it
+   * back in the free list of the queue.
+   */
+
+  else if (mqmsg->type == MQ_ALLOC_SLAB)
+    {
+      flags = spin_lock_irqsave(&g_msgfreelock);
+      list_add_tail(&msgq->msgfree, &mqmsg->node);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
+    }
+#endif
+
   /* Otherwise, deallocate it.  Note:  interrupt handlers
    * will never deallocate messages because they will not
    * received them.
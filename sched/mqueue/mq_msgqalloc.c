@@ -30,12 +30,21 @@
 #include <assert.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/sched.h>
 #include <nuttx/mqueue.h>
 
 #include "sched/sched.h"
 #include "mqueue/mqueue.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The slab of messages follows the message queue structure */
+
+#define MQ_SLAB_ALIGN(n) ALIGN_UP(n, sizeof(uintptr_t))
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -45,7 +54,9 @@
  *
  * Description:
  *   This function implements a part of the POSIX message queue open logic.
- *   It allocates and initializes a struct mqueue_inode_s structure.
+ *   It allocates and initializes a struct mqueue_inode_s structure.  With
+ *   CONFIG_MQ_SLAB, mq_maxmsg messages of mq_msgsize bytes are allocated
+ *   along with it.
  *
  * Input Parameters:
  *   attr   - The mq_maxmsg attribute is used at the time that the message
@@ -68,6 +79,15 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
                     FAR struct mqueue_inode_s **pmsgq)
 {
   FAR struct mqueue_inode_s *msgq;
+  size_t size = sizeof(struct mqueue_inode_s);
+  int16_t maxmsgs = MQ_MAX_MSGS;
+  int16_t maxmsgsize = MQ_MAX_BYTES;
+#ifdef CONFIG_MQ_SLAB
+  FAR struct mqueue_msg_s *mqmsg;
+  FAR uint8_t *slab;
+  size_t msgsize;
+  int i;
+#endif
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
@@ -79,26 +99,41 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       return -EINVAL;
     }
 
+  if (attr)
+    {
+      maxmsgs    = (int16_t)attr->mq_maxmsg;
+      maxmsgsize = (int16_t)attr->mq_msgsize;
+    }
+
+#ifdef CONFIG_MQ_SLAB
+  msgsize = MQ_SLAB_ALIGN(MQ_MSG_SIZE(maxmsgsize));
+  size    = MQ_SLAB_ALIGN(size) + maxmsgs * msgsize;
+#endif
+
   /* Allocate memory for the new message queue. */
 
-  msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+  msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(size);
 
   if (msgq)
     {
       /* Initialize the new named message queue */
 
       list_initialize(&msgq->msglist);
-      if (attr)
-        {
-          msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
-          msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
-        }
-      else
+      msgq->maxmsgs    = maxmsgs;
+      msgq->maxmsgsize = maxmsgsize;
+
+#ifdef CONFIG_MQ_SLAB
+      /* Carve the slab into messages */
+
+      list_initialize(&msgq->msgfree);
+      slab = (FAR uint8_t *)msgq + MQ_SLAB_ALIGN(sizeof(*msgq));
+      for (i = 0; i < maxmsgs; i++, slab += msgsize)
         {
-          msgq->maxmsgs    = MQ_MAX_MSGS;
-          msgq->maxmsgsize = MQ_MAX_BYTES;
+          mqmsg       = (FAR struct mqueue_msg_s *)slab;
+          mqmsg->type = MQ_ALLOC_SLAB;
+          list_add_tail(&msgq->msgfree, &mqmsg->node);
         }
+#endif
 
 #ifndef CONFIG_DISABLE_MQUEUE_NOTIFICATION
       msgq->ntpid = INVALID_PROCESS_ID;
@@ -65,7 +65,7 @@ void nxmq_free_msgq(FAR struct mqueue_inode_s *msgq)
       /* Deallocate the message structure. */
 
       list_delete(&entry->node);
-      nxmq_free_msg(entry);
+      nxmq_free_msg(msgq, entry);
     }
 
   /* Then deallocate the message queue itself */
@@ -106,14 +106,16 @@ static void nxmq_rcvtimeout(wdparm_t arg)
  *
  * Input Parameters:
  *   msgq   - Message queue descriptor
+ *   rcvbuf - The buffer into which a sender may copy the message directly,
+ *            or NULL.  The message is then not returned in rcvmsg.
  *   rcvmsg - The caller-provided location in which to return the newly
  *            received message.
  *   abstime - If non-NULL, this is the absolute time to wait until a
  *             message is received.
  *
  * Returned Value:
- *   On success, zero (OK) is returned.  A negated errno value is returned
- *   on any failure.
+ *   On success, zero (OK) is returned and rcvmsg is NULL if the message was
+ *   copied into rcvbuf.  A negated errno value is returned on any failure.
  *
  * Assumptions:
  * - The caller has provided all validity checking of the input parameters
@@ -125,6 +127,7 @@ static void nxmq_rcvtimeout(wdparm_t arg)
  ****************************************************************************/
 
 int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
+                      FAR struct mqueue_rcvbuf_s *rcvbuf,
                       FAR struct mqueue_msg_s **rcvmsg,
                       FAR const struct timespec *abstime,
                       sclock_t ticks)
@@ -171,6 +174,9 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 
       rtcb->waitobj = msgq;
       rtcb->errcode = OK;
+#ifdef CONFIG_MQ_HANDOFF
+      rtcb->mqrcvbuf = rcvbuf;
+#endif
 
       /* Remove the tcb task from the running list. */
 
@@ -195,8 +201,21 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
         {
           break;
         }
+
+#ifdef CONFIG_MQ_HANDOFF
+      /* Or (3) the sender copied the message into our buffer */
+
+      if (rcvbuf != NULL && rtcb->mqrcvbuf == NULL)
+        {
+          break;
+        }
+#endif
     }
 
+#ifdef CONFIG_MQ_HANDOFF
+  rtcb->mqrcvbuf = NULL;
+#endif
+
   if (abstime || ticks >= 0)
     {
       wd_cancel(&rtcb->waitdog);
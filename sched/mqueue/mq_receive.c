@@ -37,6 +37,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/cancelpt.h>
 
 #include "mqueue/mqueue.h"
@@ -104,6 +105,90 @@ static int nxmq_verify_receive(FAR struct file *mq,
 }
 #endif
 
+/****************************************************************************
+ * Name: nxmq_receive_msg
+ *
+ * Description:
+ *   Take the next message from the message queue, waiting for one if the
+ *   queue is empty.  This is the common part of
+ *   file_mq_timedreceive_internal() and file_mq_loanreceive().
+ *
+ * Input Parameters:
+ *   mq      - Message queue descriptor
+ *   rcvbuf  - The buffer into which a sender may copy the message directly,
+ *             or NULL
+ *   rcvmsg  - Location to return the message
+ *   abstime - the absolute time to wait until a timeout is declared
+ *   ticks   - Ticks to wait from the start time until the semaphore is
+ *             posted.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success, with rcvmsg set to NULL if the
+ *   message was copied into rcvbuf.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static int nxmq_receive_msg(FAR struct file *mq,
+                            FAR struct mqueue_rcvbuf_s *rcvbuf,
+                            FAR struct mqueue_msg_s **rcvmsg,
+                            FAR const struct timespec *abstime,
+                            sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq = mq->f_inode->i_private;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret;
+
+  /* Furthermore, nxmq_wait_receive() expects to have interrupts disabled
+   * because messages can be sent from interrupt level.
+   */
+
+  flags = enter_critical_section();
+
+  /* Get the message from the message queue */
+
+  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msglist);
+  if (mqmsg == NULL)
+    {
+      if ((mq->f_oflags & O_NONBLOCK) != 0)
+        {
+          leave_critical_section(flags);
+          return -EAGAIN;
+        }
+
+      /* Wait & get the message from the message queue */
+
+      ret = nxmq_wait_receive(msgq, rcvbuf, &mqmsg, abstime, ticks);
+      if (ret < 0 || mqmsg == NULL)
+        {
+          /* Failed, or the message was handed off and never queued */
+
+          leave_critical_section(flags);
+          *rcvmsg = NULL;
+          return ret;
+        }
+    }
+
+  /* If we got message, then decrement the number of messages in
+   * the queue while we are still in the critical section
+   */
+
+  if (msgq->nmsgs-- == msgq->maxmsgs)
+    {
+      nxmq_pollnotify(msgq, POLLOUT);
+    }
+
+  /* Notify all threads waiting for a message in the message queue */
+
+  nxmq_notify_receive(msgq);
+
+  leave_critical_section(flags);
+
+  *rcvmsg = mqmsg;
+  return OK;
+}
+
 /****************************************************************************
  * Name: file_mq_timedreceive_internal
  *
@@ -140,9 +225,8 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
                                       FAR const struct timespec *abstime,
                                       sclock_t ticks)
 {
-  FAR struct mqueue_inode_s *msgq;
+  struct mqueue_rcvbuf_s rcvbuf;
   FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
   ssize_t ret = 0;
 
   DEBUGASSERT(up_interrupt_context() == false);
@@ -171,50 +255,28 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
     }
 #endif
 
-  msgq = mq->f_inode->i_private;
-
-  /* Furthermore, nxmq_wait_receive() expects to have interrupts disabled
-   * because messages can be sent from interrupt level.
-   */
-
-  flags = enter_critical_section();
+  rcvbuf.msg    = msg;
+  rcvbuf.msglen = msglen;
+  rcvbuf.prio   = 0;
 
-  /* Get the message from the message queue */
+  ret = nxmq_receive_msg(mq, &rcvbuf, &mqmsg, abstime, ticks);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
-  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msglist);
   if (mqmsg == NULL)
     {
-      if ((mq->f_oflags & O_NONBLOCK) != 0)
-        {
-          leave_critical_section(flags);
-          return -EAGAIN;
-        }
-
-      /* Wait & get the message from the message queue */
+      /* The sender already copied the message into our buffer */
 
-      ret = nxmq_wait_receive(msgq, &mqmsg, abstime, ticks);
-      if (ret < 0)
+      if (prio)
         {
-          leave_critical_section(flags);
-          return ret;
+          *prio = rcvbuf.prio;
         }
-    }
-
-  /* If we got message, then decrement the number of messages in
-   * the queue while we are still in the critical section
-   */
 
-  if (msgq->nmsgs-- == msgq->maxmsgs)
-    {
-      nxmq_pollnotify(msgq, POLLOUT);
+      return rcvbuf.msglen;
     }
 
-  /* Notify all threads waiting for a message in the message queue */
-
-  nxmq_notify_receive(msgq);
-
-  leave_critical_section(flags);
-
   /* Return the message to the caller */
 
   if (prio)
@@ -227,7 +289,7 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
 
   /* Free the message structure */
 
-  nxmq_free_msg(mqmsg);
+  nxmq_free_msg(mq->f_inode->i_private, mqmsg);
 
   return ret;
 }
@@ -591,3 +653,81 @@ ssize_t mq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
   leave_cancellation_point();
   return ret;
 }
+
+#ifdef CONFIG_MQ_LOAN
+/****************************************************************************
+ * Name: file_mq_loanreceive
+ *
+ * Description:
+ *   Take the oldest message of highest priority from the message queue
+ *   "mq" without copying it.  It behaves like file_mq_receive() otherwise.
+ *   The buffer must be given back with file_mq_unloan().
+ *
+ * Input Parameters:
+ *   mq   - Message queue descriptor
+ *   buf  - Location to return the buffer holding the message
+ *   prio - If not NULL, location to return the priority of the message
+ *
+ * Returned Value:
+ *   The length of the message on success.  A negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_loanreceive(FAR struct file *mq, FAR void **buf,
+                            FAR unsigned int *prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  int ret;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  if (mq == NULL || mq->f_inode == NULL || buf == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if ((mq->f_oflags & O_RDOK) == 0)
+    {
+      return -EBADF;
+    }
+
+  /* Without a buffer of our own, the message always comes queued */
+
+  ret = nxmq_receive_msg(mq, NULL, &mqmsg, NULL, -1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (prio)
+    {
+      *prio = mqmsg->priority;
+    }
+
+  *buf = mqmsg->mail;
+  return mqmsg->msglen;
+}
+
+/****************************************************************************
+ * Name: file_mq_unloan
+ *
+ * Description:
+ *   Give back a buffer obtained from file_mq_loan() or
+ *   file_mq_loanreceive().  Buffers must be given back before the message
+ *   queue is closed.
+ *
+ * Input Parameters:
+ *   mq  - Message queue descriptor
+ *   buf - The borrowed buffer
+ *
+ ****************************************************************************/
+
+void file_mq_unloan(FAR struct file *mq, FAR void *buf)
+{
+  DEBUGASSERT(mq != NULL && mq->f_inode != NULL && buf != NULL);
+
+  nxmq_free_msg(mq->f_inode->i_private,
+                container_of(buf, struct mqueue_msg_s, mail));
+}
+#endif /* CONFIG_MQ_LOAN */
@@ -36,6 +36,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/irq.h>
 
@@ -110,8 +111,9 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  With CONFIG_MQ_SLAB, the message is taken from the
+ *   slab of the message queue first.  Otherwise, the message will be
+ *   allocated from the g_msgfree list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
  *   interrupt level, then the message will be allocated.  If a message
@@ -124,7 +126,8 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *   handler will be notified.
  *
  * Input Parameters:
- *   None
+ *   msgq    - The message queue the message is allocated for
+ *   msgsize - The length of the message in bytes
  *
  * Returned Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -132,15 +135,25 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *
  ****************************************************************************/
 
-static FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
+static FAR struct mqueue_msg_s *
+nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq, uint16_t msgsize)
 {
   FAR struct mqueue_msg_s *mqmsg;
   irqstate_t flags;
 
-  /* Try to get the message from the generally available free list. */
+  /* Try to get the message from the slab of the queue, then from the
+   * generally available free list.
+   */
 
   flags = spin_lock_irqsave(&g_msgfreelock);
-  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfree);
+#ifdef CONFIG_MQ_SLAB
+  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msgfree);
+  if (mqmsg == NULL)
+#endif
+    {
+      mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfree);
+    }
+
   spin_unlock_irqrestore(&g_msgfreelock, flags);
   if (mqmsg == NULL)
     {
@@ -239,6 +252,81 @@ static void nxmq_add_queue(FAR struct mqueue_inode_s *msgq,
     }
 }
 
+/****************************************************************************
+ * Name: nxmq_send_msg
+ *
+ * Description:
+ *   Add the message mqmsg to the message queue, waiting for room if the
+ *   queue is full.  This is the common part of file_mq_timedsend_internal()
+ *   and file_mq_loansend().
+ *
+ * Input Parameters:
+ *   mq      - Message queue descriptor
+ *   mqmsg   - Message to queue, with its priority and length set
+ *   abstime - the absolute time to wait until a timeout is declared
+ *   ticks   - Ticks to wait from the start time until the semaphore is
+ *             posted.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; the message then belongs to the
+ *   queue.  A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+static int nxmq_send_msg(FAR struct file *mq,
+                         FAR struct mqueue_msg_s *mqmsg,
+                         FAR const struct timespec *abstime,
+                         sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq = mq->f_inode->i_private;
+  irqstate_t flags;
+  int ret = OK;
+
+  /* Disable interruption */
+
+  flags = enter_critical_section();
+
+  if (msgq->nmsgs >= msgq->maxmsgs)
+    {
+      /* Verify that the message is full and we can't wait */
+
+      if ((up_interrupt_context() || (mq->f_oflags & O_NONBLOCK) != 0))
+        {
+          ret = -EAGAIN;
+          goto out;
+        }
+
+      /* The message queue is full.  We will need to wait for the message
+       * queue to become non-full.
+       */
+
+      ret = nxmq_wait_send(msgq, abstime, ticks);
+      if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  /* Add the message to the message queue */
+
+  nxmq_add_queue(msgq, mqmsg, mqmsg->priority);
+
+  /* Increment the count of messages in the queue */
+
+  if (msgq->nmsgs++ == 0)
+    {
+      nxmq_pollnotify(msgq, POLLIN);
+    }
+
+  /* Notify any tasks that are waiting for a message to become available */
+
+  nxmq_notify_send(msgq);
+
+out:
+  leave_critical_section(flags);
+  return ret;
+}
+
 /****************************************************************************
  * Name: file_mq_timedsend_internal
  *
@@ -279,7 +367,6 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
 {
   FAR struct mqueue_inode_s *msgq;
   FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
   int ret = 0;
 
   /* Verify the input parameters */
@@ -306,64 +393,43 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
 
   msgq = mq->f_inode->i_private;
 
-  /* Pre-allocate a message structure */
-
-  mqmsg = nxmq_alloc_msg(msglen);
-  if (!mqmsg)
-    {
-      return -ENOMEM;
-    }
-
-  memcpy(mqmsg->mail, msg, msglen);
-  mqmsg->priority = prio;
-  mqmsg->msglen   = msglen;
-
-  /* Disable interruption */
-
-  flags = enter_critical_section();
+#ifdef CONFIG_MQ_HANDOFF
+  /* If a receiver already waits on the empty queue, copy the message
+   * straight into its buffer.
+   */
 
-  if (msgq->nmsgs >= msgq->maxmsgs)
+  if (msgq->cmn.nwaitnotempty > 0)
     {
-      /* Verify that the message is full and we can't wait */
-
-      if ((up_interrupt_context() || (mq->f_oflags & O_NONBLOCK) != 0))
-        {
-          ret = -EAGAIN;
-          goto out;
-        }
+      irqstate_t flags;
+      bool handoff;
 
-      /* The message queue is full.  We will need to wait for the message
-       * queue to become non-full.
-       */
+      flags   = enter_critical_section();
+      handoff = nxmq_handoff_send(msgq, msg, msglen, prio);
+      leave_critical_section(flags);
 
-      ret = nxmq_wait_send(msgq, abstime, ticks);
-      if (ret < 0)
+      if (handoff)
         {
-          goto out;
+          return OK;
         }
     }
+#endif
 
-  /* Add the message to the message queue */
-
-  nxmq_add_queue(msgq, mqmsg, prio);
-
-  /* Increment the count of messages in the queue */
+  /* Pre-allocate a message structure */
 
-  if (msgq->nmsgs++ == 0)
+  mqmsg = nxmq_alloc_msg(msgq, msglen);
+  if (!mqmsg)
     {
-      nxmq_pollnotify(msgq, POLLIN);
+      return -ENOMEM;
     }
 
-  /* Notify any tasks that are waiting for a message to become available */
-
-  nxmq_notify_send(msgq);
-
-out:
-  leave_critical_section(flags);
+  memcpy(mqmsg->mail, msg, msglen);
+  mqmsg->priority = prio;
+  mqmsg->msglen   = msglen;
 
+  ret = nxmq_send_msg(mq, mqmsg, abstime, ticks);
   if (ret < 0)
     {
-      nxmq_free_msg(mqmsg);
+      nxmq_free_msg(msgq, mqmsg);
     }
 
   return ret;
@@ -744,3 +810,87 @@ int mq_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
   leave_cancellation_point();
   return ret;
 }
+
+#ifdef CONFIG_MQ_LOAN
+/****************************************************************************
+ * Name: file_mq_loan
+ *
+ * Description:
+ *   Borrow a message buffer of the message queue "mq".  The caller fills
+ *   the buffer in place and passes it to file_mq_loansend(), or gives it
+ *   back with file_mq_unloan().
+ *
+ * Input Parameters:
+ *   mq - Message queue descriptor
+ *
+ * Returned Value:
+ *   A buffer of the mq_msgsize attribute of the queue, or NULL if no
+ *   message could be allocated.
+ *
+ ****************************************************************************/
+
+FAR void *file_mq_loan(FAR struct file *mq)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+
+  if (mq == NULL || mq->f_inode == NULL)
+    {
+      return NULL;
+    }
+
+  msgq  = mq->f_inode->i_private;
+  mqmsg = nxmq_alloc_msg(msgq, msgq->maxmsgsize);
+  return mqmsg != NULL ? mqmsg->mail : NULL;
+}
+
+/****************************************************************************
+ * Name: file_mq_loansend
+ *
+ * Description:
+ *   Queue the borrowed buffer "buf" in the message queue "mq" without
+ *   copying it.  It behaves like file_mq_send() otherwise.
+ *
+ * Input Parameters:
+ *   mq     - Message queue descriptor
+ *   buf    - Buffer returned by file_mq_loan()
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; the buffer then belongs to the
+ *   message queue.  A negated errno value is returned on failure and the
+ *   buffer still belongs to the caller.
+ *
+ ****************************************************************************/
+
+int file_mq_loansend(FAR struct file *mq, FAR void *buf, size_t msglen,
+                     unsigned int prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+#ifdef CONFIG_DEBUG_FEATURES
+  int ret;
+#endif
+
+  if (mq == NULL || buf == NULL)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_DEBUG_FEATURES
+  /* Verify the input parameters on any failures to verify. */
+
+  ret = nxmq_verify_send(mq, buf, msglen, prio);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  mqmsg = container_of(buf, struct mqueue_msg_s, mail);
+  mqmsg->priority = prio;
+  mqmsg->msglen   = msglen;
+
+  return nxmq_send_msg(mq, mqmsg, NULL, -1);
+}
+#endif /* CONFIG_MQ_LOAN */
@@ -92,6 +92,54 @@ static void nxmq_sndtimeout(wdparm_t arg)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: nxmq_wake_receiver
+ *
+ * Description:
+ *   Wake up the highest priority task waiting for the message queue to
+ *   become non-empty.
+ *
+ * Assumptions/restrictions:
+ * - Executes within a critical section established by the caller.
+ * - At least one task is waiting.
+ *
+ ****************************************************************************/
+
+static void nxmq_wake_receiver(FAR struct mqueue_inode_s *msgq)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *btcb;
+
+  /* Find the highest priority task that is waiting for this queue to be
+   * non-empty in waitfornotempty list.  leave_critical_section() should
+   * give us sufficient protection since interrupts should never cause a
+   * change in this list
+   */
+
+  btcb = (FAR struct tcb_s *)dq_remfirst(MQ_WNELIST(msgq->cmn));
+
+  /* If one was found, unblock it */
+
+  DEBUGASSERT(btcb);
+
+  wd_cancel(&btcb->waitdog);
+
+  msgq->cmn.nwaitnotempty--;
+
+  /* Indicate that the wait is over. */
+
+  btcb->waitobj = NULL;
+
+  /* Add the task to ready-to-run task list and
+   * perform the context switch if one is needed
+   */
+
+  if (nxsched_add_readytorun(btcb))
+    {
+      up_switch_context(btcb, rtcb);
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -238,8 +286,6 @@ int nxmq_wait_send(FAR struct mqueue_inode_s *msgq,
 
 void nxmq_notify_send(FAR struct mqueue_inode_s *msgq)
 {
-  FAR struct tcb_s *btcb;
-
   /* Check if we need to notify any tasks that are attached to the
    * message queue
    */
@@ -271,36 +317,67 @@ void nxmq_notify_send(FAR struct mqueue_inode_s *msgq)
 
   if (msgq->cmn.nwaitnotempty > 0)
     {
-      FAR struct tcb_s *rtcb = this_task();
+      nxmq_wake_receiver(msgq);
+    }
+}
 
-      /* Find the highest priority task that is waiting for
-       * this queue to be non-empty in waitfornotempty
-       * list. leave_critical_section() should give us sufficient
-       * protection since interrupts should never cause a change
-       * in this list
-       */
+#ifdef CONFIG_MQ_HANDOFF
+/****************************************************************************
+ * Name: nxmq_handoff_send
+ *
+ * Description:
+ *   Copy a message straight into the buffer of the highest priority task
+ *   waiting for the message queue to become non-empty, and wake that task
+ *   up.  The message then never enters the queue.
+ *
+ * Input Parameters:
+ *   msgq   - Message queue descriptor
+ *   msg    - Message to send
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   true if the message was handed off; false if it must be queued.
+ *
+ * Assumptions/restrictions:
+ * - Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
 
-      btcb = (FAR struct tcb_s *)dq_remfirst(MQ_WNELIST(msgq->cmn));
+bool nxmq_handoff_send(FAR struct mqueue_inode_s *msgq,
+                       FAR const char *msg, size_t msglen,
+                       unsigned int prio)
+{
+  FAR struct mqueue_rcvbuf_s *rcvbuf;
+  FAR struct tcb_s *btcb;
 
-      /* If one was found, unblock it */
+  /* Queued messages go first; a waiter may just have been woken up for
+   * one of them.
+   */
 
-      DEBUGASSERT(btcb);
+  if (msgq->cmn.nwaitnotempty == 0 || !list_is_empty(&msgq->msglist))
+    {
+      return false;
+    }
 
-      wd_cancel(&btcb->waitdog);
+  /* The receiver may not have a buffer, or a too small one */
 
-      msgq->cmn.nwaitnotempty--;
+  btcb   = (FAR struct tcb_s *)dq_peek(MQ_WNELIST(msgq->cmn));
+  rcvbuf = btcb->mqrcvbuf;
+  if (rcvbuf == NULL || rcvbuf->msglen < msglen)
+    {
+      return false;
+    }
 
-      /* Indicate that the wait is over. */
+  memcpy(rcvbuf->msg, msg, msglen);
+  rcvbuf->msglen = msglen;
+  rcvbuf->prio   = prio;
 
-      btcb->waitobj = NULL;
+  /* A cleared buffer tells the receiver that the message was handed off */
 
-      /* Add the task to ready-to-run task list and
-       * perform the context switch if one is needed
-       */
+  btcb->mqrcvbuf = NULL;
 
-      if (nxsched_add_readytorun(btcb))
-        {
-          up_switch_context(btcb, rtcb);
-        }
-    }
+  nxmq_wake_receiver(msgq);
+  return true;
 }
+#endif
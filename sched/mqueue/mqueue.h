@@ -60,7 +60,8 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_SLAB        /* Pre-allocated in the slab of the message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -78,6 +79,18 @@ struct mqueue_msg_s
   char mail[1];            /* Message data */
 };
 
+/* This structure describes the buffer of a receiver blocked on an empty
+ * message queue.  With CONFIG_MQ_HANDOFF, the sender copies the message
+ * straight into it.
+ */
+
+struct mqueue_rcvbuf_s
+{
+  FAR char *msg;           /* Buffer of the receiver */
+  size_t msglen;           /* Size of the buffer, then length of message */
+  unsigned int prio;       /* Priority of the message handed off */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -117,7 +130,8 @@ void nxmq_initialize(void);
 
 /* mq_msgfree.c *************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c *************************************************************/
 
@@ -126,6 +140,7 @@ void nxmq_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 /* mq_rcvinternal.c *********************************************************/
 
 int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
+                      FAR struct mqueue_rcvbuf_s *rcvbuf,
                       FAR struct mqueue_msg_s **rcvmsg,
                       FAR const struct timespec *abstime,
                       sclock_t ticks);
@@ -137,6 +152,11 @@ int nxmq_wait_send(FAR struct mqueue_inode_s *msgq,
                    FAR const struct timespec *abstime,
                    sclock_t ticks);
 void nxmq_notify_send(FAR struct mqueue_inode_s *msgq);
+#ifdef CONFIG_MQ_HANDOFF
+bool nxmq_handoff_send(FAR struct mqueue_inode_s *msgq,
+                       FAR const char *msg, size_t msglen,
+                       unsigned int prio);
+#endif
 
 /* mq_recover.c *************************************************************/
 
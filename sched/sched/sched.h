@@ -243,6 +243,13 @@ extern volatile pid_t g_lastpid;
 extern FAR struct tcb_s **g_pidhash;
 extern volatile int g_npidhash;
 
+/* g_pidhash_lock lets the PID lookups run without the critical section.
+ * The hash table is changed with both the critical section and this lock
+ * held, so it may be read holding either of them.
+ */
+
+extern spinlock_t g_pidhash_lock;
+
 /* This is a table of task lists.  This table is indexed by the task stat
  * enumeration type (tstate_t) and provides a pointer to the associated
  * static task list (if there is one) as well as a a set of attribute flags
@@ -318,6 +325,25 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 bool nxsched_reprioritize_rtr(FAR struct tcb_s *tcb, int priority);
 
+/* Priority map of the ready-to-run list */
+
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+bool nxsched_rtrmap_add(FAR struct tcb_s *tcb);
+void nxsched_rtrmap_remove(FAR struct tcb_s *tcb);
+void nxsched_rtrmap_reset(void);
+#endif
+
+/* Change the priority of the running task without moving it.  Only in the
+ * non-SMP case is the running task part of the g_readytorun list.
+ */
+
+#if defined(CONFIG_SCHED_READYTORUN_MAP) && !defined(CONFIG_SMP)
+void nxsched_rtrmap_setpriority(FAR struct tcb_s *tcb, int priority);
+#else
+#  define nxsched_rtrmap_setpriority(tcb, priority) \
+     ((tcb)->sched_priority = (uint8_t)(priority))
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -389,6 +415,13 @@ static inline_function FAR struct tcb_s *this_task(void)
 
 #ifdef CONFIG_SMP
 void nxsched_process_delivered(int cpu);
+#  ifdef CONFIG_SCHED_WORKSTEAL
+FAR struct tcb_s *nxsched_steal_task(int cpu, int priority);
+FAR struct tcb_s *nxsched_peek_steal(int cpu, int priority);
+#    if CONFIG_SCHED_WORKSTEAL_INTERVAL > 0
+void nxsched_worksteal_initialize(void);
+#    endif
+#  endif
 #else
 #  define nxsched_select_cpu(a)     (0)
 #endif
@@ -450,6 +483,15 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+  /* The ready-to-run list is indexed, no need to walk it */
+
+  if (list == list_readytorun())
+    {
+      return nxsched_rtrmap_add(tcb);
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
@@ -517,6 +559,20 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
   return ret;
 }
 
+static inline_function void nxsched_remove_prioritized(FAR struct tcb_s *tcb,
+                                                       DSEG dq_queue_t *list)
+{
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+  if (list == list_readytorun())
+    {
+      nxsched_rtrmap_remove(tcb);
+      return;
+    }
+#endif
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
 #  ifdef CONFIG_SMP
 static inline_function int nxsched_select_cpu(cpu_set_t affinity)
 {
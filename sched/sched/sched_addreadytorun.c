@@ -216,9 +216,21 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
        * Add the task to the ready-to-run (but not running) task list
        */
 
+#ifdef CONFIG_SCHED_WORKSTEAL
+      /* Queue the task on the selected CPU.  It will run there when it
+       * reaches the head of the assigned task list, unless another CPU
+       * steals it first.
+       */
+
+      nxsched_add_prioritized(btcb, list_assignedtasks(cpu));
+
+      btcb->cpu        = cpu;
+      btcb->task_state = TSTATE_TASK_ASSIGNED;
+#else
       nxsched_add_prioritized(btcb, list_readytorun());
 
       btcb->task_state = TSTATE_TASK_READYTORUN;
+#endif
       doswitch         = false;
     }
   else /* (task_state == TSTATE_TASK_RUNNING) */
@@ -98,6 +98,13 @@ clock_t g_preemp_max[CONFIG_SMP_NCPUS];
 
 #if CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0
 clock_t g_crit_max[CONFIG_SMP_NCPUS];
+
+/* Total time within critical section, i.e. holding the global lock.  It
+ * is a sum rather than a single interval, so it is kept in 64 bits even
+ * when clock_t is 32 bits wide.
+ */
+
+uint64_t g_crit_total[CONFIG_SMP_NCPUS];
 #endif
 
 /****************************************************************************
@@ -257,6 +264,8 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
         {
           g_crit_max[cpu] = elapsed;
         }
+
+      g_crit_total[cpu] += elapsed;
     }
 }
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
@@ -389,6 +398,8 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
         {
           g_crit_max[cpu] = elapsed;
         }
+
+      g_crit_total[cpu] += elapsed;
     }
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION */
 }
@@ -28,7 +28,7 @@
 
 #include <sched.h>
 
-#include "nuttx/irq.h"
+#include <nuttx/spinlock.h>
 
 #include "sched/sched.h"
 
@@ -43,12 +43,12 @@
  *   Given a task ID, this function will return the a pointer to the
  *   corresponding TCB (or NULL if there is no such task ID).
  *
- *   NOTE:  This function holds a critical section while examining TCB data
- *   data structures but releases that critical section before returning.
- *   When it is released, the TCB may become unstable.  If the caller
- *   requires absolute stability while using the TCB, then the caller
- *   should establish the critical section BEFORE calling this function and
- *   hold that critical section as long as necessary.
+ *   NOTE:  This function holds g_pidhash_lock while examining the PID hash
+ *   table but releases it before returning.  When it is released, the TCB
+ *   may become unstable.  If the caller requires absolute stability while
+ *   using the TCB, then the caller should establish the critical section
+ *   BEFORE calling this function and hold that critical section as long
+ *   as necessary.
  *
  ****************************************************************************/
 
@@ -58,7 +58,7 @@ FAR struct tcb_s *nxsched_get_tcb(pid_t pid)
   irqstate_t flags;
   int hash_ndx;
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&g_pidhash_lock);
 
   /* Verify whether g_pidhash hash table has already been allocated and
    * whether the PID is within range.
@@ -86,7 +86,7 @@ FAR struct tcb_s *nxsched_get_tcb(pid_t pid)
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore(&g_pidhash_lock, flags);
 
   /* Return the TCB. */
 
@@ -75,9 +75,11 @@
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
-  FAR struct tcb_s *pnext;
   FAR struct tcb_s *rtcb;
+#ifndef CONFIG_SCHED_READYTORUN_MAP
+  FAR struct tcb_s *pnext;
   FAR struct tcb_s *rprev;
+#endif
   bool ret = false;
 
   /* Initialize the inner search loop */
@@ -91,6 +93,27 @@ bool nxsched_merge_pending(void)
 
   if (!nxsched_islocked_tcb(rtcb))
     {
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+      /* The indexed ready-to-run list finds the spot of each ptcb without
+       * walking.
+       */
+
+      while ((ptcb = (FAR struct tcb_s *)
+                     dq_remfirst(list_pendingtasks())) != NULL)
+        {
+          if (nxsched_rtrmap_add(ptcb))
+            {
+              ptcb->flink->task_state = TSTATE_TASK_READYTORUN;
+              ptcb->task_state        = TSTATE_TASK_RUNNING;
+              up_update_task(ptcb);
+              ret                     = true;
+            }
+          else
+            {
+              ptcb->task_state = TSTATE_TASK_READYTORUN;
+            }
+        }
+#else
       for (ptcb = (FAR struct tcb_s *)list_pendingtasks()->head;
            ptcb;
            ptcb = pnext)
@@ -157,6 +180,7 @@ bool nxsched_merge_pending(void)
 
       list_pendingtasks()->head = NULL;
       list_pendingtasks()->tail = NULL;
+#endif
     }
 
   return ret;
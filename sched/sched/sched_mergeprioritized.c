@@ -80,6 +80,13 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   dq_move(list1, &clone);
 
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+  if (list1 == list_readytorun())
+    {
+      nxsched_rtrmap_reset();
+    }
+#endif
+
   /* Get the TCB at the head of list1 */
 
   tcb1 = (FAR struct tcb_s *)dq_peek(&clone);
@@ -102,6 +109,22 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       tmp->task_state = task_state;
     }
 
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+  /* The indexed ready-to-run list takes the TCBs one by one, each insertion
+   * costs the same as a merge step.
+   */
+
+  if (list2 == list_readytorun())
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_remfirst(&clone)) != NULL)
+        {
+          nxsched_rtrmap_add(tmp);
+        }
+
+      return;
+    }
+#endif
+
   /* Get the head of list2 */
 
   tcb2 = (FAR struct tcb_s *)dq_peek(list2);
@@ -52,7 +52,10 @@
 static void nxsched_releasepid(pid_t pid)
 {
   irqstate_t flags = enter_critical_section();
-  int hash_ndx = PIDHASH(pid);
+  int hash_ndx;
+
+  spin_lock(&g_pidhash_lock);
+  hash_ndx = PIDHASH(pid);
 
 #ifndef CONFIG_SCHED_CPULOAD_NONE
   /* Decrement the total CPU load count held by this thread from the
@@ -69,6 +72,7 @@ static void nxsched_releasepid(pid_t pid)
 
   g_pidhash[hash_ndx] = NULL;
 
+  spin_unlock(&g_pidhash_lock);
   leave_critical_section(flags);
 }
 
@@ -93,7 +93,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  nxsched_remove_prioritized(rtcb, tasklist);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -184,6 +184,7 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
 
   dq_rem_head((FAR dq_entry_t *)tcb, tasklist);
 
+#ifndef CONFIG_SCHED_WORKSTEAL
   /* Find the highest priority non-running tasks in the g_assignedtasks
    * list of other CPUs, and also non-idle tasks, place them in the
    * g_readytorun list. so as to find the task with the highest priority,
@@ -224,6 +225,7 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
             }
         }
     }
+#endif
 
   /* Which task will go at the head of the list?  It will be either the
    * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -253,13 +255,30 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
        * list and add to the head of the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtrtcb, &g_readytorun);
+      nxsched_remove_prioritized(rtrtcb, &g_readytorun);
       dq_addfirst_nonempty((FAR dq_entry_t *)rtrtcb, tasklist);
 
       rtrtcb->cpu = cpu;
       nxttcb = rtrtcb;
     }
 
+#ifdef CONFIG_SCHED_WORKSTEAL
+  /* Steal a task queued on another CPU if it has a higher priority than
+   * the best local candidate.  Only the stolen task migrates, the queues
+   * of the other CPUs are otherwise left alone.
+   */
+
+  rtrtcb = nxsched_steal_task(cpu, nxttcb->sched_priority);
+  if (rtrtcb != NULL)
+    {
+      dq_addfirst_nonempty((FAR dq_entry_t *)rtrtcb, tasklist);
+      nxttcb->task_state = TSTATE_TASK_ASSIGNED;
+
+      rtrtcb->cpu = cpu;
+      nxttcb = rtrtcb;
+    }
+#endif
+
   /* NOTE: If the task runs on another CPU(cpu), adjusting global IRQ
    * controls will be done in the pause handler on the new CPU(cpu).
    * If the task is scheduled on this CPU(me), do nothing because
@@ -318,7 +337,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *tcb)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      nxsched_remove_prioritized(tcb, tasklist);
 
       /* Since the TCB is no longer in any list, it is now invalid */
 
@@ -0,0 +1,264 @@
+/****************************************************************************
+ * sched/sched/sched_rtrmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYTORUN_MAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RTRMAP_NWORDS  ((SCHED_PRIORITY_MAX + 32) >> 5)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The TCBs of one priority form a FIFO segment of the g_readytorun list.
+ * g_rtrtail[] holds the last TCB of each segment and g_rtrmap[] has one
+ * bit set for each priority with a non-empty segment.  The IDLE task at
+ * the end of the list needs no entry since nothing is ever placed after
+ * it.
+ */
+
+static FAR struct tcb_s *g_rtrtail[SCHED_PRIORITY_MAX + 1];
+static uint32_t g_rtrmap[RTRMAP_NWORDS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtrmap_above
+ *
+ * Description:
+ *   Return the lowest priority above 'priority' that has ready-to-run
+ *   tasks, or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int nxsched_rtrmap_above(int priority)
+{
+  uint32_t bits;
+  int i;
+
+  if (++priority > SCHED_PRIORITY_MAX)
+    {
+      return -1;
+    }
+
+  i    = priority >> 5;
+  bits = g_rtrmap[i] & (UINT32_MAX << (priority & 31));
+
+  while (bits == 0)
+    {
+      if (++i >= RTRMAP_NWORDS)
+        {
+          return -1;
+        }
+
+      bits = g_rtrmap[i];
+    }
+
+  return (i << 5) + ffs(bits) - 1;
+}
+
+static void nxsched_rtrmap_set(FAR struct tcb_s *tcb, int priority)
+{
+  g_rtrtail[priority]     = tcb;
+  g_rtrmap[priority >> 5] |= 1u << (priority & 31);
+}
+
+static void nxsched_rtrmap_clear(int priority)
+{
+  g_rtrtail[priority]     = NULL;
+  g_rtrmap[priority >> 5] &= ~(1u << (priority & 31));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtrmap_add
+ *
+ * Description:
+ *   Add a TCB to the g_readytorun list after all the TCBs with the same or
+ *   a higher priority.
+ *
+ * Input Parameters:
+ *   tcb - Points to the TCB to add
+ *
+ * Returned Value:
+ *   true if the TCB was added at the head of the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_rtrmap_add(FAR struct tcb_s *tcb)
+{
+  FAR dq_queue_t *list = list_readytorun();
+  FAR struct tcb_s *prev;
+  int priority = tcb->sched_priority;
+  int above;
+
+  /* The TCB follows its own segment or the segment of the nearest higher
+   * priority.
+   */
+
+  prev = g_rtrtail[priority];
+  if (prev == NULL)
+    {
+      above = nxsched_rtrmap_above(priority);
+      prev  = above < 0 ? NULL : g_rtrtail[above];
+    }
+
+  nxsched_rtrmap_set(tcb, priority);
+
+  if (prev == NULL)
+    {
+      tcb->blink = NULL;
+      tcb->flink = (FAR struct tcb_s *)list->head;
+      if (list->head != NULL)
+        {
+          list->head->blink = (FAR dq_entry_t *)tcb;
+        }
+      else
+        {
+          list->tail = (FAR dq_entry_t *)tcb;
+        }
+
+      list->head = (FAR dq_entry_t *)tcb;
+      return true;
+    }
+
+  tcb->blink = prev;
+  tcb->flink = prev->flink;
+  if (prev->flink != NULL)
+    {
+      prev->flink->blink = tcb;
+    }
+  else
+    {
+      list->tail = (FAR dq_entry_t *)tcb;
+    }
+
+  prev->flink = tcb;
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtrmap_remove
+ *
+ * Description:
+ *   Remove a TCB from the g_readytorun list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_rtrmap_remove(FAR struct tcb_s *tcb)
+{
+  FAR struct tcb_s *prev = tcb->blink;
+  int priority = tcb->sched_priority;
+
+  if (g_rtrtail[priority] == tcb)
+    {
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          g_rtrtail[priority] = prev;
+        }
+      else
+        {
+          nxsched_rtrmap_clear(priority);
+        }
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list_readytorun());
+}
+
+/****************************************************************************
+ * Name: nxsched_rtrmap_setpriority
+ *
+ * Description:
+ *   Change in place the priority of the TCB at the head of the
+ *   g_readytorun list, i.e. the running task.  The caller assures that the
+ *   new priority is not below the priority of the next TCB, so the TCB
+ *   becomes the first of the segment of the new priority.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SMP
+void nxsched_rtrmap_setpriority(FAR struct tcb_s *tcb, int priority)
+{
+  DEBUGASSERT(tcb->blink == NULL);
+
+  if (g_rtrtail[tcb->sched_priority] == tcb)
+    {
+      nxsched_rtrmap_clear(tcb->sched_priority);
+    }
+
+  tcb->sched_priority = (uint8_t)priority;
+  if (g_rtrtail[priority] == NULL)
+    {
+      nxsched_rtrmap_set(tcb, priority);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsched_rtrmap_reset
+ *
+ * Description:
+ *   Forget all the segments after the g_readytorun list has been emptied
+ *   as a whole.
+ *
+ ****************************************************************************/
+
+void nxsched_rtrmap_reset(void)
+{
+  memset(g_rtrtail, 0, sizeof(g_rtrtail));
+  memset(g_rtrmap, 0, sizeof(g_rtrmap));
+}
+
+#endif /* CONFIG_SCHED_READYTORUN_MAP */
@@ -125,18 +125,30 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
            rtrtcb != NULL && !CPU_ISSET(tcb->cpu, &rtrtcb->affinity);
            rtrtcb = rtrtcb->flink);
 
-      /* Return the TCB from the readyt-to-run list if it is the next
-       * highest priority task.
+      /* Use the TCB from the ready-to-run list if it is the next highest
+       * priority task.
        */
 
       if (rtrtcb != NULL &&
           rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
-          return rtrtcb;
+          nxttcb = rtrtcb;
         }
+
+#ifdef CONFIG_SCHED_WORKSTEAL
+      /* A task queued on another CPU is stolen when the running task gives
+       * up tcb->cpu, if it has a higher priority than the local candidate.
+       */
+
+      rtrtcb = nxsched_peek_steal(tcb->cpu, nxttcb->sched_priority);
+      if (rtrtcb != NULL)
+        {
+          nxttcb = rtrtcb;
+        }
+#endif
     }
 
-  /* Otherwise, return the next TCB in the g_assignedtasks[] list...
+  /* Otherwise, this is the next TCB in the g_assignedtasks[] list...
    * probably the TCB of the IDLE thread.
    * REVISIT:  What if it is not the IDLE thread?
    */
@@ -216,7 +228,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
           /* Change the task priority */
 
-          tcb->sched_priority = (uint8_t)sched_priority;
+          nxsched_rtrmap_setpriority(tcb, sched_priority);
         }
       else
         {
@@ -262,7 +274,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
     {
       /* Change the task priority */
 
-      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_rtrmap_setpriority(tcb, sched_priority);
     }
 }
 
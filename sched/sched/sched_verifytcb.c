@@ -73,9 +73,9 @@ bool nxsched_verify_tcb(FAR struct tcb_s *tcb)
   irqstate_t flags;
   bool valid;
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&g_pidhash_lock);
   valid = tcb == g_pidhash[PIDHASH(tcb->pid)];
-  leave_critical_section(flags);
+  spin_unlock_irqrestore(&g_pidhash_lock, flags);
 
   return valid;
 }
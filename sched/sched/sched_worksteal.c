@@ -0,0 +1,333 @@
+/****************************************************************************
+ * sched/sched/sched_worksteal.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/wdog.h>
+
+#include "sched/queue.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_WORKSTEAL
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if CONFIG_SCHED_WORKSTEAL_INTERVAL > 0
+static struct wdog_s g_worksteal_wdog;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_queue_length
+ *
+ * Description:
+ *   Return the load of a CPU, i.e. the number of tasks waiting in its
+ *   assigned task list behind the running task, not counting the IDLE
+ *   task.
+ *
+ ****************************************************************************/
+
+static int nxsched_queue_length(int cpu)
+{
+  FAR struct tcb_s *tcb;
+  int nqueued = 0;
+
+  for (tcb = current_task(cpu)->flink;
+       tcb != NULL && !is_idle_task(tcb);
+       tcb = tcb->flink)
+    {
+      nqueued++;
+    }
+
+  return nqueued;
+}
+
+/****************************************************************************
+ * Name: nxsched_find_victim
+ *
+ * Description:
+ *   Find the highest priority task that is queued on another CPU, may run
+ *   on 'cpu' and has a priority above 'minprio' but not above 'maxprio'.
+ *   Between tasks of the same priority, the one queued on the CPU with the
+ *   longest queue is preferred.  Only CPUs with at least 'minqueue' queued
+ *   tasks are considered.
+ *
+ * Returned Value:
+ *   The TCB of the task, still in its assigned task list, or NULL if there
+ *   is no such task.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_find_victim(int cpu, int minprio,
+                                             int maxprio, int minqueue)
+{
+  FAR struct tcb_s *victim = NULL;
+  FAR struct tcb_s *tcb;
+  int nvictim = 0;
+  int nqueued;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      /* The assigned task list is in descending priority order, so the
+       * first eligible task is the best one of this CPU.
+       */
+
+      for (tcb = current_task(i)->flink;
+           tcb != NULL && !is_idle_task(tcb);
+           tcb = tcb->flink)
+        {
+          if (tcb->sched_priority <= minprio)
+            {
+              tcb = NULL;
+              break;
+            }
+
+          if (tcb->sched_priority <= maxprio &&
+              CPU_ISSET(cpu, &tcb->affinity))
+            {
+              break;
+            }
+        }
+
+      if (tcb == NULL || is_idle_task(tcb))
+        {
+          continue;
+        }
+
+      nqueued = nxsched_queue_length(i);
+      if (nqueued >= minqueue &&
+          (victim == NULL ||
+           tcb->sched_priority > victim->sched_priority ||
+           (tcb->sched_priority == victim->sched_priority &&
+            nqueued > nvictim)))
+        {
+          victim  = tcb;
+          nvictim = nqueued;
+        }
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: nxsched_steal_from
+ *
+ * Description:
+ *   Like nxsched_find_victim(), but also remove the task from its assigned
+ *   task list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_steal_from(int cpu, int minprio,
+                                            int maxprio, int minqueue)
+{
+  FAR struct tcb_s *victim;
+
+  victim = nxsched_find_victim(cpu, minprio, maxprio, minqueue);
+  if (victim != NULL)
+    {
+      /* The victim is neither the running task at the head of its list
+       * nor the IDLE task at the tail.
+       */
+
+      DEBUGASSERT(victim->task_state == TSTATE_TASK_ASSIGNED);
+      dq_rem_mid(victim);
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: nxsched_rebalance
+ *
+ * Description:
+ *   Periodically rebalance the per-CPU queues:  A CPU pulls the highest
+ *   priority task queued elsewhere that would preempt its running task,
+ *   the IDLE task included.  Otherwise, a CPU whose queue is at least two
+ *   tasks shorter than the longest queue pulls a task that does not
+ *   preempt its running task.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_WORKSTEAL_INTERVAL > 0
+static void nxsched_rebalance(wdparm_t arg)
+{
+  FAR struct wdog_s *wdog = (FAR struct wdog_s *)arg;
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      /* Leave alone a CPU that is about to receive a task */
+
+      if (g_delivertasks[cpu] != NULL)
+        {
+          continue;
+        }
+
+      /* A task queued behind the running task of another CPU may have
+       * been left there when this CPU lowered the priority of its running
+       * task.
+       */
+
+      rtcb = current_task(cpu);
+      tcb  = nxsched_steal_from(cpu, rtcb->sched_priority,
+                                SCHED_PRIORITY_MAX, 1);
+      if (tcb != NULL)
+        {
+          /* Let the normal placement logic start the task on the CPU
+           * with the lowest priority running task.
+           */
+
+          rtcb = this_task();
+          if (nxsched_add_readytorun(tcb))
+            {
+              up_switch_context(this_task(), rtcb);
+            }
+        }
+      else if (!is_idle_task(rtcb))
+        {
+          tcb = nxsched_steal_from(cpu, 0, rtcb->sched_priority,
+                                   nxsched_queue_length(cpu) + 2);
+          if (tcb != NULL)
+            {
+              /* The task does not preempt the running task, so it goes
+               * somewhere behind the head of the list.
+               */
+
+              nxsched_add_prioritized(tcb, &g_assignedtasks[cpu]);
+              tcb->cpu = cpu;
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+
+  wd_start_next(wdog, CONFIG_SCHED_WORKSTEAL_INTERVAL, nxsched_rebalance,
+                arg);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_steal_task
+ *
+ * Description:
+ *   Called when the running task of 'cpu' gives up the CPU.  Steal the
+ *   highest priority task queued on another CPU that may run on 'cpu', if
+ *   its priority is above 'priority', the priority of the best task 'cpu'
+ *   could run otherwise.
+ *
+ * Input Parameters:
+ *   cpu      - The CPU looking for work
+ *   priority - The priority the stolen task must exceed
+ *
+ * Returned Value:
+ *   The TCB of the stolen task, already removed from its assigned task
+ *   list, or NULL.  The caller assigns the task to 'cpu' and sets its
+ *   state.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_steal_task(int cpu, int priority)
+{
+  return nxsched_steal_from(cpu, priority, SCHED_PRIORITY_MAX, 1);
+}
+
+/****************************************************************************
+ * Name: nxsched_peek_steal
+ *
+ * Description:
+ *   Return the task that nxsched_steal_task() would steal, without
+ *   removing it from its assigned task list.
+ *
+ * Input Parameters:
+ *   cpu      - The CPU looking for work
+ *   priority - The priority the task must exceed
+ *
+ * Returned Value:
+ *   The TCB of the task or NULL.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_peek_steal(int cpu, int priority)
+{
+  return nxsched_find_victim(cpu, priority, SCHED_PRIORITY_MAX, 1);
+}
+
+/****************************************************************************
+ * Name: nxsched_worksteal_initialize
+ *
+ * Description:
+ *   Start the periodic rebalancing of the per-CPU queues.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_WORKSTEAL_INTERVAL > 0
+void nxsched_worksteal_initialize(void)
+{
+  wd_start(&g_worksteal_wdog, CONFIG_SCHED_WORKSTEAL_INTERVAL,
+           nxsched_rebalance, (wdparm_t)&g_worksteal_wdog);
+}
+#endif
+
+#endif /* CONFIG_SCHED_WORKSTEAL */
@@ -34,10 +34,101 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/mm/kmap.h>
+#include <nuttx/spinlock.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_MUTEX_ADAPTIVE_SPIN) && CONFIG_MUTEX_ADAPTIVE_SPIN > 0
+#  define NXSEM_ADAPTIVE_SPIN 1
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef NXSEM_ADAPTIVE_SPIN
+/****************************************************************************
+ * Name: nxsem_holder_running
+ *
+ * Description:
+ *   Check whether the task 'pid' is running on a CPU.  The TCBs are not
+ *   locked, the answer is only a hint.
+ *
+ ****************************************************************************/
+
+static bool nxsem_holder_running(pid_t pid)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct tcb_s *tcb = current_task(cpu);
+
+      if (tcb != NULL && tcb->pid == pid)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_spin_mutex
+ *
+ * Description:
+ *   Poll the mutex 'sem' while its holder runs on another CPU, expecting
+ *   that it will be released soon, and take it if it is.  This saves the
+ *   two context switches of blocking.  Spinning stops as soon as the holder
+ *   is not running, as other tasks block on the mutex already, or after
+ *   CONFIG_MUTEX_ADAPTIVE_SPIN polls.
+ *
+ *   A mutex taken here is taken as by the fast path of nxsem_wait().
+ *   Priority inheritance is unaffected, the holder is running and tasks
+ *   which stop spinning block and boost it as usual.
+ *
+ * Returned Value:
+ *   true if the mutex was taken; false if the caller must block.
+ *
+ ****************************************************************************/
+
+static bool nxsem_spin_mutex(FAR sem_t *sem, FAR struct tcb_s *rtcb)
+{
+  FAR atomic_t *mholder = NXSEM_MHOLDER(sem);
+  int32_t holder;
+  int spin;
+
+  for (spin = 0; spin < CONFIG_MUTEX_ADAPTIVE_SPIN; spin++)
+    {
+      holder = atomic_read(mholder);
+      if (holder == NXSEM_NO_MHOLDER)
+        {
+          if (atomic_try_cmpxchg_acquire(mholder, &holder, rtcb->pid))
+            {
+              return true;
+            }
+
+          continue;
+        }
+
+      if (NXSEM_MBLOCKING(holder) || holder == NXSEM_MRESET ||
+          holder == rtcb->pid || !nxsem_holder_running(holder))
+        {
+          break;
+        }
+
+      UP_DSB();
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -78,6 +169,21 @@ int nxsem_wait_slow(FAR sem_t *sem)
   FAR struct tcb_s *htcb = NULL;
   bool mutex = NXSEM_IS_MUTEX(sem);
 
+#ifdef NXSEM_ADAPTIVE_SPIN
+  /* On SMP, the holder of a mutex may be about to release it on another
+   * CPU.  Spin a little before blocking, unless we hold the critical
+   * section which the other CPUs may need, or the mutex has a priority
+   * ceiling to apply.
+   */
+
+  if (mutex && rtcb->irqcount == 0 && !up_interrupt_context() &&
+      (sem->flags & SEM_PRIO_MASK) != SEM_PRIO_PROTECT &&
+      nxsem_spin_mutex(sem, rtcb))
+    {
+      return OK;
+    }
+#endif
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -38,6 +38,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/queue.h>
 
 #include "sched/sched.h"
@@ -292,7 +293,8 @@ static void nxsig_dispatch_kernel_action(FAR struct tcb_s *stcb,
  *   all of memory.
  *
  * Assumptions:
- *   Called with tg_sigpendingq locked
+ *   Called within a critical section.  The list changes are also made
+ *   holding the group's tg_lock.
  *
  ****************************************************************************/
 
@@ -313,7 +315,9 @@ static FAR sigpendq_t *nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
     {
       /* The signal is already pending... retain only one copy */
 
+      spin_lock(&group->tg_lock);
       memcpy(&sigpend->info, info, sizeof(siginfo_t));
+      spin_unlock(&group->tg_lock);
     }
 
   /* No... There is nothing pending in the group for this signo */
@@ -335,9 +339,13 @@ static FAR sigpendq_t *nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
 
           sigpend->tcb = group_dispatch ? NULL : stcb;
 
-          /* Add the structure to the group pending signal list */
+          /* Add the structure to the group pending signal list.  Readers
+           * such as nxsig_pendingset() hold only tg_lock.
+           */
 
+          spin_lock(&group->tg_lock);
           sq_addlast((FAR sq_entry_t *)sigpend, &group->tg_sigpendingq);
+          spin_unlock(&group->tg_lock);
         }
     }
 
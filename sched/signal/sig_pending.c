@@ -31,6 +31,7 @@
 #include <assert.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/signal.h>
 
 #include "sched/sched.h"
@@ -73,7 +74,9 @@ int sigpending(FAR sigset_t *set)
  * Name: nxsig_pendingset
  *
  * Description:
- *   Convert the list of pending signals into a signal set
+ *   Convert the list of pending signals into a signal set.  The list is
+ *   only changed holding both the critical section and the group's
+ *   tg_lock, so reading it needs only tg_lock.
  *
  ****************************************************************************/
 
@@ -97,7 +100,7 @@ sigset_t nxsig_pendingset(FAR struct tcb_s *stcb)
 
   sigemptyset(&sigpendset);
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&group->tg_lock);
   for (sigpend = (FAR sigpendq_t *)group->tg_sigpendingq.head;
        (sigpend); sigpend = sigpend->flink)
     {
@@ -107,7 +110,7 @@ sigset_t nxsig_pendingset(FAR struct tcb_s *stcb)
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore(&group->tg_lock, flags);
 
   return sigpendset;
 }
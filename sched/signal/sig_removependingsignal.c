@@ -34,6 +34,7 @@
 #include <sched.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
@@ -62,6 +63,7 @@ FAR sigpendq_t *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb, int signo)
   DEBUGASSERT(group);
 
   flags = enter_critical_section();
+  spin_lock(&group->tg_lock);
 
   /* If stcb == NULL, the signal is for whole group. Otherwise only
    * remove the one which is to be delivered to the stcb
@@ -85,6 +87,7 @@ FAR sigpendq_t *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb, int signo)
         }
     }
 
+  spin_unlock(&group->tg_lock);
   leave_critical_section(flags);
 
   return currsig;
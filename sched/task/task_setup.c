@@ -100,10 +100,12 @@ static int nxtask_assign_pid(FAR struct tcb_s *tcb)
 retry:
 
   /* Protect the following operation with a critical section
-   * because g_pidhash is accessed from an interrupt context
+   * because g_pidhash is accessed from an interrupt context.  The PID
+   * lookups hold g_pidhash_lock instead.
    */
 
   flags = enter_critical_section();
+  spin_lock(&g_pidhash_lock);
 
   /* Get the next process ID candidate */
 
@@ -131,6 +133,7 @@ retry:
           tcb->pid = next_pid;
           g_lastpid = next_pid;
 
+          spin_unlock(&g_pidhash_lock);
           leave_critical_section(flags);
           return OK;
         }
@@ -150,6 +153,7 @@ retry:
    * and if successful, return directly
    */
 
+  spin_unlock(&g_pidhash_lock);
   leave_critical_section(flags);
   pidhash = kmm_zalloc(g_npidhash * 2 * sizeof(*pidhash));
   if (pidhash == NULL)
@@ -160,8 +164,10 @@ retry:
   /* Handle conner case: context switch happened when kmm_malloc */
 
   flags = enter_critical_section();
+  spin_lock(&g_pidhash_lock);
   if (temp != g_pidhash)
     {
+      spin_unlock(&g_pidhash_lock);
       leave_critical_section(flags);
       kmm_free(pidhash);
       goto retry;
@@ -193,6 +199,7 @@ retry:
   /* Release resource for original g_pidhash, using new g_pidhash */
 
   g_pidhash = pidhash;
+  spin_unlock(&g_pidhash_lock);
   leave_critical_section(flags);
   kmm_free(temp);
 
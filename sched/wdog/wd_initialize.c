@@ -41,7 +41,9 @@ spinlock_t g_wdspinlock = SP_UNLOCKED;
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 struct list_node g_wdactivelist = LIST_INITIAL_VALUE(g_wdactivelist);
+#endif
 
 /****************************************************************************
  * Public Functions
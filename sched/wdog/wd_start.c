@@ -97,6 +97,44 @@ static unsigned int g_wdtimernested;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_expired
+ *
+ * Description:
+ *   Remove and return the first watchdog that is ready to run at 'ticks',
+ *   or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct wdog_s *wd_expired(clock_t ticks)
+{
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  UNUSED(ticks);
+  return wd_wheel_expired();
+#else
+  FAR struct wdog_s *wdog;
+
+  if (list_is_empty(&g_wdactivelist))
+    {
+      return NULL;
+    }
+
+  wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+
+  /* Check if expected time is expired */
+
+  if (!clock_compare(wdog->expired, ticks))
+    {
+      return NULL;
+    }
+
+  /* Remove the watchdog from the head of the list */
+
+  list_delete(&wdog->node);
+  return wdog;
+#endif
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -129,25 +167,21 @@ static inline_function void wd_expiration(clock_t ticks)
   g_wdtimernested++;
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Move all the watchdogs that expired by now to the expired list at
+   * once.  Watchdogs started by the callbacks with an expiration time
+   * already reached are added to the same list and run in this same pass.
+   */
+
+  wd_wheel_advance(ticks);
+#endif
+
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
    */
 
-  while (!list_is_empty(&g_wdactivelist))
+  while ((wdog = wd_expired(ticks)) != NULL)
     {
-      wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
-
-      /* Check if expected time is expired */
-
-      if (!clock_compare(wdog->expired, ticks))
-        {
-          break;
-        }
-
-      /* Remove the watchdog from the head of the list */
-
-      list_delete(&wdog->node);
-
       /* Indicate that the watchdog is no longer active. */
 
       func = wdog->func;
@@ -198,6 +232,18 @@ static inline_function
 bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  /* File the wdog in the timer wheel and return whether the next
+   * watchdog event has changed.
+   */
+
+  return wd_wheel_insert(wdog);
+#else
   FAR struct wdog_s *curr;
   FAR struct wdog_s *head;
 
@@ -232,6 +278,7 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   /* Return whether the head of the watchdog list has changed. */
 
   return head == curr;
+#endif
 }
 
 /****************************************************************************
@@ -298,8 +345,12 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      reassess |= wd_wheel_remove(wdog);
+#else
       reassess |= list_is_head(&g_wdactivelist, &wdog->node);
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
@@ -326,7 +377,11 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      wd_wheel_remove(wdog);
+#else
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
@@ -416,7 +471,11 @@ int wd_start(FAR struct wdog_s *wdog, clock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t wd_timer(clock_t ticks, bool noswitches)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t next;
+#else
   FAR struct wdog_s *wdog;
+#endif
   irqstate_t flags;
   sclock_t ret;
 
@@ -431,6 +490,19 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   /* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* The next event may be a slot of the wheel that has to be filed again
+   * before the watchdogs in it expire.  Waking up for it is harmless.
+   */
+
+  if (!wd_wheel_next(&next))
+    {
+      spin_unlock_irqrestore(&g_wdspinlock, flags);
+      return 0;
+    }
+
+  ret = next - ticks;
+#else
   if (list_is_empty(&g_wdactivelist))
     {
       spin_unlock_irqrestore(&g_wdspinlock, flags);
@@ -443,6 +515,7 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
   ret = wdog->expired - ticks;
+#endif
 
   spin_unlock_irqrestore(&g_wdspinlock, flags);
 
@@ -0,0 +1,418 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WHEEL_BITS        5
+#define WHEEL_SLOTS       (1 << WHEEL_BITS)
+#define WHEEL_MASK        (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS      CONFIG_WDOG_TIMER_WHEEL_LEVELS
+
+/* Level n of the wheel has a resolution of 2^WHEEL_SHIFT(n) ticks */
+
+#define WHEEL_SHIFT(n)    ((n) * WHEEL_BITS)
+#define WHEEL_SPAN(n)     ((clock_t)1 << WHEEL_SHIFT(n))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* A watchdog that expires at tick 'expired' is filed in the lowest level
+ * whose span covers the delay from the next tick to process, in the slot
+ * selected by the bits of 'expired' at that level.  When the processing
+ * reaches the start of a slot of a higher level, the watchdogs of that
+ * slot are filed again in the lower levels.  The watchdogs of a slot of
+ * level 0 all expire at the same tick.
+ *
+ * The slot heads are initialized when the first watchdog is filed in
+ * them, g_wdwheelmap[] has one bit set for each non-empty slot.
+ */
+
+static struct list_node g_wdwheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t g_wdwheelmap[WHEEL_LEVELS];
+
+/* The watchdogs that expired and whose functions have not been called yet,
+ * in the order of expiration.
+ */
+
+static struct list_node g_wdexpired = LIST_INITIAL_VALUE(g_wdexpired);
+
+/* The last tick processed */
+
+static clock_t g_wdbase;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_splice
+ *
+ * Description:
+ *   Move all the watchdogs of a slot to the tail of the list 'to'.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_splice(int level, int slot, FAR struct list_node *to)
+{
+  FAR struct list_node *head = &g_wdwheel[level][slot];
+
+  if ((g_wdwheelmap[level] & (1u << slot)) == 0)
+    {
+      return;
+    }
+
+  g_wdwheelmap[level] &= ~(1u << slot);
+
+  head->next->prev = to->prev;
+  head->prev->next = to;
+  to->prev->next   = head->next;
+  to->prev         = head->prev;
+
+  list_initialize(head);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_file
+ *
+ * Description:
+ *   File a watchdog in the wheel, or in the expired list if it expires no
+ *   later than the last tick processed.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_file(FAR struct wdog_s *wdog)
+{
+  clock_t next = g_wdbase + 1;
+  clock_t delta;
+  int level;
+  int slot;
+
+  if (clock_compare(wdog->expired, g_wdbase))
+    {
+      list_add_tail(&g_wdexpired, &wdog->node);
+      return;
+    }
+
+  delta = wdog->expired - next;
+  for (level = 0; level < WHEEL_LEVELS - 1; level++)
+    {
+      if (delta < WHEEL_SPAN(level + 1))
+        {
+          break;
+        }
+    }
+
+  if ((delta >> WHEEL_SHIFT(level)) > WHEEL_MASK)
+    {
+      /* Beyond the span of the wheel.  Park the watchdog in the slot of
+       * the top level that comes due last; it will be filed again then.
+       */
+
+      slot = ((next >> WHEEL_SHIFT(level)) + WHEEL_MASK) & WHEEL_MASK;
+    }
+  else
+    {
+      slot = (wdog->expired >> WHEEL_SHIFT(level)) & WHEEL_MASK;
+    }
+
+  if ((g_wdwheelmap[level] & (1u << slot)) == 0)
+    {
+      list_initialize(&g_wdwheel[level][slot]);
+      g_wdwheelmap[level] |= 1u << slot;
+    }
+
+  list_add_tail(&g_wdwheel[level][slot], &wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_event
+ *
+ * Description:
+ *   Return the first tick after the last tick processed at which a slot
+ *   comes due.  This is the exact expiration time of the next watchdog if
+ *   it is in level 0, an earlier time otherwise.
+ *
+ * Returned Value:
+ *   false if the wheel is empty.
+ *
+ ****************************************************************************/
+
+static bool wd_wheel_event(FAR clock_t *event)
+{
+  clock_t next = g_wdbase + 1;
+  clock_t delta = 0;
+  clock_t start;
+  bool found = false;
+  uint32_t map;
+  int level;
+  int idx;
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      map = g_wdwheelmap[level];
+      if (map == 0)
+        {
+          continue;
+        }
+
+      /* The first slot of this level that starts at or after 'next' */
+
+      start = (next >> WHEEL_SHIFT(level)) +
+              ((next & (WHEEL_SPAN(level) - 1)) != 0);
+      idx   = start & WHEEL_MASK;
+
+      if (idx != 0)
+        {
+          map = (map >> idx) | (map << (WHEEL_SLOTS - idx));
+        }
+
+      start = (start + ffs(map) - 1) << WHEEL_SHIFT(level);
+      if (!found || start - next < delta)
+        {
+          delta = start - next;
+          found = true;
+        }
+    }
+
+  *event = next + delta;
+  return found;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ *
+ * Description:
+ *   Process one tick:  File again the watchdogs of the higher level slots
+ *   that start at this tick and move the watchdogs that expire at this
+ *   tick to the expired list.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_tick(clock_t tick)
+{
+  FAR struct list_node *node;
+  struct list_node pending;
+  int level;
+
+  list_initialize(&pending);
+  g_wdbase = tick - 1;
+
+  for (level = 1; level < WHEEL_LEVELS; level++)
+    {
+      if ((tick & (WHEEL_SPAN(level) - 1)) != 0)
+        {
+          break;
+        }
+
+      wd_wheel_splice(level, (tick >> WHEEL_SHIFT(level)) & WHEEL_MASK,
+                      &pending);
+    }
+
+  while (!list_is_empty(&pending))
+    {
+      node = pending.next;
+      list_delete(node);
+      wd_wheel_file(list_entry(node, struct wdog_s, node));
+    }
+
+  wd_wheel_splice(0, tick & WHEEL_MASK, &g_wdexpired);
+  g_wdbase = tick;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the time of the next watchdog event:  The last tick processed
+ *   if there are expired watchdogs, else the time of the next slot that
+ *   comes due.
+ *
+ * Returned Value:
+ *   false if no watchdog is active.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_next(FAR clock_t *next)
+{
+  if (!list_is_empty(&g_wdexpired))
+    {
+      *next = g_wdbase;
+      return true;
+    }
+
+  return wd_wheel_event(next);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog, with its expiration time already set, to the wheel.
+ *
+ * Returned Value:
+ *   Whether the time of the next watchdog event has changed.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  clock_t before;
+  clock_t after;
+  bool active;
+
+  active = wd_wheel_next(&before);
+  if (!active)
+    {
+      /* Nothing was active, so with a tickless timer the last tick
+       * processed may lag far behind.  Catch up with the current time.
+       */
+
+      g_wdbase = clock_systime_ticks() - 1;
+    }
+
+  wd_wheel_file(wdog);
+  wd_wheel_next(&after);
+
+  return !active || after != before;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the wheel or from the expired list.
+ *
+ * Returned Value:
+ *   Whether the time of the next watchdog event has changed.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct list_node *prev = wdog->node.prev;
+  uintptr_t offset;
+  clock_t before;
+  clock_t after;
+
+  wd_wheel_next(&before);
+
+  /* If the watchdog is alone in a slot, that slot becomes empty */
+
+  offset = (uintptr_t)prev - (uintptr_t)g_wdwheel;
+  if (prev == wdog->node.next && offset < sizeof(g_wdwheel))
+    {
+      offset /= sizeof(struct list_node);
+      g_wdwheelmap[offset / WHEEL_SLOTS] &= ~(1u << (offset % WHEEL_SLOTS));
+    }
+
+  list_delete(&wdog->node);
+
+  return !wd_wheel_next(&after) || after != before;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Process all the ticks up to 'ticks', moving the watchdogs that expired
+ *   to the expired list.  Ticks at which no slot comes due are skipped.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+void wd_wheel_advance(clock_t ticks)
+{
+  clock_t event;
+
+  while (clock_compare(g_wdbase + 1, ticks))
+    {
+      if (!wd_wheel_event(&event) || !clock_compare(event, ticks))
+        {
+          g_wdbase = ticks;
+          break;
+        }
+
+      wd_wheel_tick(event);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return the first expired watchdog, or NULL.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+  FAR struct list_node *node = g_wdexpired.next;
+
+  if (node == &g_wdexpired)
+    {
+      return NULL;
+    }
+
+  list_delete(node);
+  return list_entry(node, struct wdog_s, node);
+}
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
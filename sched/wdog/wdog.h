@@ -64,7 +64,9 @@ extern "C"
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 extern struct list_node g_wdactivelist;
+#endif
 extern spinlock_t g_wdspinlock;
 
 /****************************************************************************
@@ -125,6 +127,30 @@ void wd_timer(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   The hierarchical timer wheel that replaces g_wdactivelist when
+ *   CONFIG_WDOG_TIMER_WHEEL is selected.  wd_wheel_insert() and
+ *   wd_wheel_remove() return whether the time of the next watchdog event
+ *   changed, wd_wheel_next() returns that time.  wd_wheel_advance() moves
+ *   the watchdogs that expired up to 'ticks' to the expired list and
+ *   wd_wheel_expired() takes them off one by one.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+bool wd_wheel_insert(FAR struct wdog_s *wdog);
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+bool wd_wheel_next(FAR clock_t *next);
+void wd_wheel_advance(clock_t ticks);
+FAR struct wdog_s *wd_wheel_expired(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
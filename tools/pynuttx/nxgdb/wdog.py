@@ -47,7 +47,40 @@ class WDog(Value, p.WDog):
         return self.__repr__()
 
 
+def get_wheel_list(wheel: Value) -> List[WDog]:
+    """Get the watchdogs of CONFIG_WDOG_TIMER_WHEEL in expiration order"""
+
+    wdogs = []
+    expired = utils.parse_and_eval("g_wdexpired")
+    for wdog in lists.NxList(expired, "struct wdog_s", "node"):
+        wdogs.append(WDog(wdog))
+
+    # Only the slots with their bit set in the map have an initialized head
+
+    wheelmap = utils.parse_and_eval("g_wdwheelmap")
+    pending = []
+    for level in range(utils.nitems(wheel)):
+        slots = wheel[level]
+        for slot in range(utils.nitems(slots)):
+            if int(wheelmap[level]) & (1 << slot) == 0:
+                continue
+
+            for wdog in lists.NxList(slots[slot], "struct wdog_s", "node"):
+                pending.append(WDog(wdog))
+
+    # The ticks wrap around, order them by their distance from the last
+    # processed tick.
+
+    base = int(utils.parse_and_eval("g_wdbase"))
+    mask = (1 << (8 * utils.sizeof("clock_t"))) - 1
+    pending.sort(key=lambda wdog: (int(wdog.expired) - base) & mask)
+    return wdogs + pending
+
+
 def get_wdog_list() -> List[WDog]:
+    if (wheel := utils.gdb_eval_or_none("g_wdwheel")) is not None:
+        return get_wheel_list(wheel)
+
     wdogs = []
     active = utils.parse_and_eval("g_wdactivelist")
     for wdog in lists.NxList(active, "struct wdog_s", "node"):